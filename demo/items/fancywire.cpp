@@ -13,7 +13,7 @@
 
 #include <boost/serialization/export.hpp>
 
-#define SIZE (_settings.gridSize/3)
+#define SIZE (_settings->gridSize/3)
 
 FancyWire::FancyWire(QGraphicsItem* parent) :
     QSchematic::Items::WireRoundedCorners(::ItemType::FancyWireType, parent)
@@ -21,7 +21,7 @@ FlowEnd::FlowEnd() :
     Operation(::ItemType::FlowEndType)
 {
     // Symbol polygon
-    const int sz = _settings.gridSize;
+    const int sz = _settings->gridSize;
     _symbolPolygon << QPoint(1*sz, -1*sz);
     _symbolPolygon << QPoint(0*sz, 0*sz);
     _symbolPolygon << QPoint(1*sz, 1*sz);
@@ -35,8 +35,8 @@ FlowEnd::FlowEnd() :
     // Connector
     auto connector = std::make_shared<OperationConnector>();
     connector->setParentItem(this);
-    connector->label()->setVisible(false);
-    connector->label()->setMovable(false);
+    connector->ensureLabel()->setVisible(false);
+    connector->ensureLabel()->setMovable(false);
     connector->setGridPosX(1);
     connector->setGridPosY(1);
     addConnector(connector);
@@ -86,8 +86,7 @@ QRectF FlowEnd::boundingRect() const
 
 void FlowEnd::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    QSchematic::Items::Item::paint(painter, option, widget);
 
     // Symbol
     {
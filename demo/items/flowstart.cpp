@@ -21,7 +21,7 @@ FlowStart::FlowStart() :
     Operation(::ItemType::FlowStartType)
 {
     // Symbol polygon
-    const int sz = _settings.gridSize;
+    const int sz = _settings->gridSize;
     _symbolPolygon << QPoint(1*sz, 1*sz);
     _symbolPolygon << QPoint(2*sz, 0*sz);
     _symbolPolygon << QPoint(1*sz, -1*sz);
@@ -35,8 +35,8 @@ FlowStart::FlowStart() :
     // Connector
     auto connector = std::make_shared<OperationConnector>();
     connector->setParentItem(this);
-    connector->label()->setVisible(false);
-    connector->label()->setMovable(false);
+    connector->ensureLabel()->setVisible(false);
+    connector->ensureLabel()->setMovable(false);
     connector->setGridPos(1, 0);
     addConnector(connector);
 
@@ -85,8 +85,7 @@ QRectF FlowStart::boundingRect() const
 
 void FlowStart::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    QSchematic::Items::Item::paint(painter, option, widget);
 
     // Symbol
     {
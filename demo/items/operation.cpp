@@ -142,11 +142,10 @@ QString Operation::text() const
 
 void Operation::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    QSchematic::Items::Item::paint(painter, option, widget);
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
@@ -155,7 +154,7 @@ void Operation::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     // Body
     {
         // Common stuff
-        qreal radius = _settings.gridSize/2;
+        qreal radius = _settings->gridSize/2;
 
         // Body
         {
@@ -280,7 +279,7 @@ void Operation::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
                 return;
 
             auto clone = deepCopy();
-            clone->setPos( pos() + QPointF(5*_settings.gridSize, 5*_settings.gridSize));
+            clone->setPos( pos() + QPointF(5*_settings->gridSize, 5*_settings->gridSize));
             scene()->addItem(std::move(clone));
         });
 
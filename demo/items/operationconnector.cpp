@@ -13,7 +13,7 @@
 #include <QMenu>
 #include <QInputDialog>
 
-#define SIZE (_settings.gridSize/2)
+#define SIZE (_settings->gridSize/2)
 #define RECT (QRectF(-SIZE, -SIZE, 2*SIZE, 2*SIZE))
 
 const QColor COLOR_BODY_FILL   = QColor(Qt::white);
@@ -23,7 +23,7 @@ const qreal PEN_WIDTH          = 1.5;
 OperationConnector::OperationConnector(const QPoint& gridPoint, const QString& text, QGraphicsItem* parent) :
     QSchematic::Items::Connector(::ItemType::OperationConnectorType, gridPoint, text, parent)
 {
-    label()->setVisible(true);
+    ensureLabel()->setVisible(true);
     setForceTextDirection(false);
 }
 
@@ -64,11 +64,10 @@ QRectF OperationConnector::boundingRect() const
 
 void OperationConnector::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    QSchematic::Items::Item::paint(painter, option, widget);
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
@@ -111,13 +110,13 @@ void OperationConnector::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
         // Label visibility
         QAction* labelVisibility = new QAction;
         labelVisibility->setCheckable(true);
-        labelVisibility->setChecked(label()->isVisible());
+        labelVisibility->setChecked(ensureLabel()->isVisible());
         labelVisibility->setText("Label visible");
         connect(labelVisibility, &QAction::toggled, [this](bool enabled) {
             if (scene()) {
-                scene()->undoStack()->push(new QSchematic::Commands::ItemVisibility(label(), enabled));
+                scene()->undoStack()->push(new QSchematic::Commands::ItemVisibility(ensureLabel(), enabled));
             } else {
-                label()->setVisible(enabled);
+                ensureLabel()->setVisible(enabled);
             }
         });
 
@@ -131,16 +130,16 @@ void OperationConnector::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
                 "Rename Connector",
                 "New connector text",
                 QLineEdit::Normal,
-                label()->text(),
+                this->text(),
                 &ok
             );
             if (!ok)
                 return;
 
             if (scene()) {
-                scene()->undoStack()->push(new QSchematic::Commands::LabelRename(label().get(), newText));
+                scene()->undoStack()->push(new QSchematic::Commands::LabelRename(ensureLabel().get(), newText));
             } else {
-                label()->setText(newText);
+                ensureLabel()->setText(newText);
             }
         });
 
@@ -24,7 +24,7 @@ OperationDemo1::OperationDemo1(QGraphicsItem* parent) :
 
     for (const auto& c : connectorAttributes) {
         auto connector = std::make_shared<OperationConnector>(c.point, c.name);
-        connector->label()->setVisible(true);
+        connector->ensureLabel()->setVisible(true);
         addConnector(connector);
     }
 }
@@ -21,7 +21,7 @@ public:
         // Main layout
         auto layout = new QFormLayout;
         layout->addRow("Type:", new QLabel("Connector"));
-        layout->addRow("Name:", new QLabel(conn.label()->text()));
+        layout->addRow("Name:", new QLabel(conn.text()));
         setLayout(layout);
     }
 
@@ -1,10 +1,20 @@
 #include <QApplication>
+#include <QDir>
+#include <QStandardPaths>
+
+#include <qschematic/utils/pixmapcache.hpp>
 
 #include "mainwindow.hpp"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // Persist rendered item pixmaps (library thumbnails, drag previews)
+    const QString& cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheDir.isEmpty())
+        QSchematic::ItemUtils::PixmapCache::instance().setDiskCacheDirectory(QDir(cacheDir).filePath("pixmaps"));
+
     MainWindow w;
     w.show();
 
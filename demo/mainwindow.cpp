@@ -11,6 +11,7 @@
 #include <boost/archive/xml_oarchive.hpp>
 #include <fstream>
 
+#include <qschematic/minimap.hpp>
 #include <qschematic/scene.hpp>
 #include <qschematic/view.hpp>
 #include <qschematic/commands/item_add.hpp>
@@ -108,6 +109,14 @@ MainWindow::MainWindow(QWidget *parent)
     netlistviewerDockWidget->setWidget(_netlistViewerWidget);
     addDockWidget(Qt::LeftDockWidgetArea, netlistviewerDockWidget);
 
+    // Minimap
+    auto minimap = new QSchematic::Minimap(this);
+    minimap->setView(_view);
+    QDockWidget* minimapDockWidget = new QDockWidget;
+    minimapDockWidget->setWindowTitle(QStringLiteral("Overview"));
+    minimapDockWidget->setWidget(minimap);
+    addDockWidget(Qt::LeftDockWidgetArea, minimapDockWidget);
+
     // Menus
     {
         // File menu
@@ -47,8 +47,7 @@ void Model::setNetlist(const QSchematic::Netlist<Operation*, OperationConnector*
             netItem->appendChild( connectorsItem );
             for ( const auto& connector : net.connectors ) {
                 Q_ASSERT( connector );
-                Q_ASSERT( connector->label() );
-                TreeItem* connectorItem = new TreeItem( { connector->label()->text(), pointerToString( connector ) } );
+                TreeItem* connectorItem = new TreeItem( { connector->text(), pointerToString( connector ) } );
                 connectorsItem->appendChild( connectorItem );
             }
 
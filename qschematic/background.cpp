@@ -1,10 +1,17 @@
 #include "background.hpp"
 
+#include <QPaintDevice>
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
+#include <QtMath>
+
+#include <cmath>
 
 using namespace QSchematic;
 
+// Grid tiles up to this size (in device pixels) are rendered through a cached brush pattern
+const int GRID_TILE_MAX_RESOLUTION = 64;
+
 Background::Background(QGraphicsItem* parent) :
     QGraphicsRectItem(parent)
 {
@@ -37,6 +44,15 @@ void
 Background::setSettings(const Settings& settings)
 {
     m_settings = settings;
+
+    m_grid_pen.setWidth(m_settings.gridPointSize);
+    setCacheMode(static_cast<QGraphicsItem::CacheMode>(m_settings.cacheModeBackground));
+
+    // Invalidate the grid tile
+    m_grid_tile_key = { };
+    m_grid_tile = { };
+
+    update();
 }
 
 void
@@ -55,17 +71,8 @@ Background::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
     painter->drawRect(er);
 
     // Draw the grid if supposed to
-    if (m_settings.showGrid && (m_settings.gridSize > 0)) {
-        const qreal left = int(er.left()) - (int(er.left()) % m_settings.gridSize);
-        const qreal top = int(er.top()) - (int(er.top()) % m_settings.gridSize);
-
-        painter->setPen(m_grid_pen);
-        painter->setBrush(m_grid_brush);
-        for (qreal x = left; x < er.right(); x += m_settings.gridSize) {
-            for (qreal y = top; y < er.bottom(); y += m_settings.gridSize)
-                painter->drawPoint(x, y);
-        }
-    }
+    if (m_settings.showGrid && (m_settings.gridSize > 0))
+        drawGrid(*painter, er, option ? option->levelOfDetailFromTransform(painter->worldTransform()) : 1.0);
 
     // Mark the origin if supposed to
     if (m_settings.debug) {
@@ -76,3 +83,72 @@ Background::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
 
     painter->restore();
 }
+
+void
+Background::drawGrid(QPainter& painter, const QRectF& rect, const qreal lod)
+{
+    // Sanity check
+    if (lod <= 0)
+        return;
+
+    // Decimate grid points which would end up too close to each other on screen
+    int cellSize = m_settings.gridSize;
+    while (cellSize * lod < m_settings.gridPointMinSpacing)
+        cellSize *= 2;
+
+    const int left = static_cast<int>(std::floor(rect.left() / cellSize)) * cellSize;
+    const int top = static_cast<int>(std::floor(rect.top() / cellSize)) * cellSize;
+
+    // Use a cached tile as the brush pattern
+    const int resolution = qCeil(cellSize * lod);
+    if (resolution <= GRID_TILE_MAX_RESOLUTION) {
+        const qreal dpr = painter.device() ? painter.device()->devicePixelRatioF() : 1.0;
+        const QPixmap& tile = gridTile({ cellSize, resolution, dpr });
+
+        // The brush pattern is anchored at the origin (which is a grid point). Scale the tile so that one tile covers
+        // exactly one cell in item coordinates.
+        QBrush brush(tile);
+        brush.setTransform(QTransform::fromScale(qreal(cellSize) / resolution, qreal(cellSize) / resolution));
+        painter.fillRect(rect, brush);
+
+        return;
+    }
+
+    // Batch the remaining points
+    QVector<QPointF> points;
+    points.reserve(qCeil((rect.right() - left) / cellSize) * qCeil((rect.bottom() - top) / cellSize));
+    for (qreal x = left; x < rect.right(); x += cellSize) {
+        for (qreal y = top; y < rect.bottom(); y += cellSize)
+            points.append(QPointF(x, y));
+    }
+
+    painter.setPen(m_grid_pen);
+    painter.setBrush(m_grid_brush);
+    painter.drawPoints(points.constData(), points.size());
+}
+
+const QPixmap&
+Background::gridTile(const GridTileKey& key)
+{
+    if (key == m_grid_tile_key && !m_grid_tile.isNull())
+        return m_grid_tile;
+
+    const int size = qCeil(key.resolution * key.devicePixelRatio);
+    m_grid_tile = QPixmap(size, size);
+    m_grid_tile.setDevicePixelRatio(key.devicePixelRatio);
+    m_grid_tile.fill(Qt::transparent);
+
+    // Render the point at every corner so that it shows up in full once the tiles get stitched together
+    QPainter painter(&m_grid_tile);
+    painter.setRenderHint(QPainter::Antialiasing, m_settings.antialiasing);
+    painter.scale(qreal(key.resolution) / key.cellSize, qreal(key.resolution) / key.cellSize);
+    painter.setPen(m_grid_pen);
+    painter.setBrush(m_grid_brush);
+    for (const QPointF& corner : { QPointF(0, 0), QPointF(key.cellSize, 0), QPointF(0, key.cellSize), QPointF(key.cellSize, key.cellSize) })
+        painter.drawPoint(corner);
+    painter.end();
+
+    m_grid_tile_key = key;
+
+    return m_grid_tile;
+}
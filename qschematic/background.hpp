@@ -5,6 +5,7 @@
 
 #include <QBrush>
 #include <QPen>
+#include <QPixmap>
 #include <QGraphicsRectItem>
 
 namespace QSchematic
@@ -52,8 +53,38 @@ namespace QSchematic
             return m_settings;
         }
 
+        /**
+         * Draws the grid points within a rectangle.
+         *
+         * @details Grid points are decimated (only every n-th point is drawn) when their on-screen spacing falls
+         *          below Settings::gridPointMinSpacing. For small on-screen spacings the grid pattern is rendered once
+         *          into a cached tile which is then used as a brush pattern. Otherwise, the points are batched into a
+         *          single drawPoints() call.
+         *
+         * @param painter The painter.
+         * @param rect The rectangle to fill, in item coordinates.
+         * @param lod The level of detail (device pixels per scene unit).
+         */
+        void
+        drawGrid(QPainter& painter, const QRectF& rect, qreal lod);
+
     private:
+        struct GridTileKey
+        {
+            int cellSize = 0;
+            int resolution = 0;
+            qreal devicePixelRatio = 0;
+
+            bool operator==(const GridTileKey&) const = default;
+        };
+
+        [[nodiscard]]
+        const QPixmap&
+        gridTile(const GridTileKey& key);
+
         Settings m_settings;
+        GridTileKey m_grid_tile_key;
+        QPixmap m_grid_tile;
     };
 
 }
@@ -21,3 +21,26 @@ Base::handleDependencyDestruction(const QObject* dependency)
 
     setObsolete(true);
 }
+
+std::size_t
+Base::memoryFootprint() const
+{
+    std::size_t bytes = sizeof(*this);
+    for (int i = 0; i < childCount(); i++) {
+        if (auto base = dynamic_cast<const Base*>(child(i)))
+            bytes += base->memoryFootprint();
+        else
+            bytes += sizeof(QUndoCommand);
+    }
+
+    return bytes;
+}
+
+void
+Base::compact()
+{
+    for (int i = 0; i < childCount(); i++) {
+        if (auto base = dynamic_cast<Base*>(const_cast<QUndoCommand*>(child(i))))
+            base->compact();
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <QUndoCommand>
 
+#include <cstddef>
+
 namespace QSchematic::Commands
 {
     class Base :
@@ -27,6 +29,28 @@ namespace QSchematic::Commands
          */
         void
         handleDependencyDestruction(const QObject* dependency);
+
+        /**
+         * Get the approximate amount of memory held by this command.
+         *
+         * @details The default implementation accounts for the command object itself and its child commands.
+         *
+         * @return The number of bytes.
+         */
+        [[nodiscard]]
+        virtual
+        std::size_t
+        memoryFootprint() const;
+
+        /**
+         * Reduce the memory held by this command while keeping it undoable/redoable.
+         *
+         * @details This gets called on old commands once the scene's undo memory budget is exceeded. The default
+         *          implementation compacts the child commands.
+         */
+        virtual
+        void
+        compact();
     };
 
 }
@@ -12,6 +12,7 @@ namespace QSchematic::Commands
         RectItemRotateCommandType,
         WireNetRenameCommandType,
         WirePointMoveCommandType,
+        ItemsAddCommandType,
 
         QSchematicCommandUserType = 1000
     };
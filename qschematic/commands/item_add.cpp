@@ -33,27 +33,33 @@ ItemAdd::mergeWith(const QUndoCommand* command)
 void
 ItemAdd::undo()
 {
-    if (!_scene || !_item)
+    // Bring back the item if it was spilled to disk
+    auto item = _item.item();
+
+    if (!_scene || !item)
         return;
 
     // Is this a wire?
-    auto wire = std::dynamic_pointer_cast<Items::Wire>(_item);
+    auto wire = std::dynamic_pointer_cast<Items::Wire>(item);
     if (wire)
         _scene->removeWire(wire);
 
     // Otherwise, fall back to normal item behavior
     else
-        _scene->removeItem(_item);
+        _scene->removeItem(item);
 }
 
 void
 ItemAdd::redo()
 {
-    if (!_scene || !_item)
+    // Bring back the item if it was spilled to disk
+    auto item = _item.item();
+
+    if (!_scene || !item)
         return;
 
     // Is this a wire?
-    auto wire = std::dynamic_pointer_cast<Items::Wire>(_item);
+    auto wire = std::dynamic_pointer_cast<Items::Wire>(item);
     if (wire) {
         if (wire->net()) {
             if (!_scene->wire_manager()->nets().contains(wire->net()))
@@ -71,5 +77,24 @@ ItemAdd::redo()
 
     // Otherwise, fall back to normal item behavior
     else
-        _scene->addItem(_item);
+        _scene->addItem(item);
+}
+
+std::size_t
+ItemAdd::memoryFootprint() const
+{
+    return Base::memoryFootprint() + ItemSpill::footprint(_item.peek());
+}
+
+void
+ItemAdd::compact()
+{
+    Base::compact();
+
+    // Only spill items which are not part of the scene. Wires are kept as they're tied to their net.
+    const Items::Item* item = _item.peek();
+    if (!item || item->scene() || dynamic_cast<const Items::Wire*>(item))
+        return;
+
+    _item.spill();
 }
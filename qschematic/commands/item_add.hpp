@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <QPointer>
 #include <memory>
@@ -27,10 +28,12 @@ namespace QSchematic::Commands
         bool mergeWith(const QUndoCommand* command)  override;
         void undo()  override;
         void redo()  override;
+        std::size_t memoryFootprint() const override;
+        void compact() override;
 
     private:
         QPointer<Scene> _scene;
-        std::shared_ptr<Items::Item> _item;
+        ItemSpill _item;
     };
 
 }
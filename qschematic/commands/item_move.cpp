@@ -2,6 +2,7 @@
 #include "item_move.hpp"
 #include "../items/item.hpp"
 #include "../items/wire.hpp"
+#include "../scene.hpp"
 
 #include <memory>
 
@@ -17,6 +18,10 @@ ItemMove::ItemMove(
     _items{ items },
     _moveBy{ std::move(moveBy) }
 {
+    _pins.reserve(_items.count());
+    for (const auto& item : _items)
+        _pins << ItemPin(item.get());
+
     if (_items.count() > 1)
         setText(tr("Move items"));
     else
@@ -50,17 +55,28 @@ ItemMove::mergeWith(const QUndoCommand* command)
 void
 ItemMove::undo()
 {
-    for (auto& item : _items)
-        item->moveBy(-_moveBy);
-
-    simplifyWires();
+    moveItems(-_moveBy);
 }
 
 void
 ItemMove::redo()
 {
+    moveItems(_moveBy);
+}
+
+void
+ItemMove::moveItems(const QVector2D& moveBy) const
+{
+    // Use the batched path of the scene if possible
+    if (!_items.isEmpty()) {
+        if (Scene* scene = _items.first()->scene()) {
+            scene->moveItems(_items, moveBy);
+            return;
+        }
+    }
+
     for (auto& item : _items)
-        item->moveBy(_moveBy);
+        item->moveBy(moveBy);
 
     simplifyWires();
 }
@@ -70,6 +86,6 @@ ItemMove::simplifyWires() const
 {
     for (const auto& item : _items) {
         if (auto wire = item->sharedPtr<Items::Wire>())
-            wire->simplify();
+            wire->simplify_modified();
     }
 }
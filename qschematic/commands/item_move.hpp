@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <QVector>
 #include <QVector2D>
@@ -34,8 +35,12 @@ namespace QSchematic::Commands
 
     private:
         QVector<std::shared_ptr<Items::Item>> _items;
+        QVector<ItemPin> _pins;     // Keep the parents of the items from being spilled
         QVector2D _moveBy;
 
+        void
+        moveItems(const QVector2D& moveBy) const;
+
         void
         simplifyWires() const;
     };
@@ -35,13 +35,16 @@ ItemRemove::mergeWith(const QUndoCommand* command)
 void
 ItemRemove::undo()
 {
-    if (!_scene || !_item)
+    // Bring back the item if it was spilled to disk
+    auto item = _item.item();
+
+    if (!_scene || !item)
         return;
 
-    _scene->addItem(_item);
+    _scene->addItem(item);
 
     // Is this a wire?
-    if ( auto wire = std::dynamic_pointer_cast<Items::Wire>(_item) ) {
+    if ( auto wire = std::dynamic_pointer_cast<Items::Wire>(item) ) {
         auto oldNet = wire->net();
         if (!_scene->wire_manager()->nets().contains(oldNet))
             _scene->wire_manager()->add_net(wire->net());
@@ -52,24 +55,46 @@ ItemRemove::undo()
     }
 
     // Set the item's old parent
-    _item->setParentItem(_itemParent);
+    item->setParentItem(_itemParent);
 }
 
 void
 ItemRemove::redo()
 {
-    if (!_scene || !_item)
+    // Bring back the item if it was spilled to disk
+    auto item = _item.item();
+
+    if (!_scene || !item)
         return;
 
     // Store the parent
-    _itemParent = _item->parentItem();
+    _itemParent = item->parentItem();
 
     // Is this a wire?
-    auto wire = std::dynamic_pointer_cast<Items::Wire>(_item);
+    auto wire = std::dynamic_pointer_cast<Items::Wire>(item);
     if (wire)
         _scene->removeWire(wire);
 
     // Otherwise, fall back to normal item behavior
     else
-        _scene->removeItem(_item);
+        _scene->removeItem(item);
+}
+
+std::size_t
+ItemRemove::memoryFootprint() const
+{
+    return Base::memoryFootprint() + ItemSpill::footprint(_item.peek());
+}
+
+void
+ItemRemove::compact()
+{
+    Base::compact();
+
+    // Only spill items which are not part of the scene. Wires are kept as they're tied to their net.
+    const Items::Item* item = _item.peek();
+    if (!item || item->scene() || _itemParent || dynamic_cast<const Items::Wire*>(item))
+        return;
+
+    _item.spill();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <QPointer>
 
@@ -31,10 +32,12 @@ namespace QSchematic::Commands
         bool mergeWith(const QUndoCommand* command) override;
         void undo() override;
         void redo() override;
+        std::size_t memoryFootprint() const override;
+        void compact() override;
 
     private:
         QPointer<Scene> _scene;
-        std::shared_ptr<Items::Item> _item;
+        ItemSpill _item;
         QGraphicsItem* _itemParent = nullptr;   // ToDo: Should this be a smart-ptr too?
     };
 
@@ -0,0 +1,234 @@
+#include "item_spill.hpp"
+#include "../items/item.hpp"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+
+#include <sstream>
+
+using namespace QSchematic;
+using namespace QSchematic::Commands;
+
+// Rough estimate of the memory held by a single graphics item
+const std::size_t ITEM_FOOTPRINT_ESTIMATE = 1024;
+
+struct ItemSpill::Slot
+{
+    ~Slot();
+
+    std::shared_ptr<Items::Item> item;
+    std::unique_ptr<QTemporaryFile> file;
+};
+
+QHash<const Items::Item*, std::weak_ptr<ItemSpill::Slot>>&
+ItemSpill::registry()
+{
+    static QHash<const Items::Item*, std::weak_ptr<Slot>> registry;
+
+    return registry;
+}
+
+QHash<const QGraphicsItem*, int>&
+ItemSpill::pins()
+{
+    static QHash<const QGraphicsItem*, int> pins;
+
+    return pins;
+}
+
+bool
+ItemSpill::isPinned(const QGraphicsItem* item)
+{
+    const auto& pinned = pins();
+    if (pinned.isEmpty())
+        return false;
+
+    QList<const QGraphicsItem*> items{ item };
+    while (!items.isEmpty()) {
+        const QGraphicsItem* current = items.takeLast();
+        if (pinned.contains(current))
+            return true;
+        for (const QGraphicsItem* child : current->childItems())
+            items << child;
+    }
+
+    return false;
+}
+
+ItemSpill::Slot::~Slot()
+{
+    if (item)
+        registry().remove(item.get());
+}
+
+ItemSpill::ItemSpill(const std::shared_ptr<Items::Item>& item)
+{
+    if (!item)
+        return;
+
+    // Share the slot with the other commands holding this item
+    auto& known = registry();
+    _slot = known.value(item.get()).lock();
+    if (_slot && _slot->item == item)
+        return;
+
+    _slot = std::make_shared<Slot>();
+    _slot->item = item;
+    known.insert(item.get(), _slot);
+}
+
+std::shared_ptr<Items::Item>
+ItemSpill::item()
+{
+    if (!_slot)
+        return nullptr;
+    if (!_slot->file)
+        return _slot->item;
+
+    // Read
+    if (!_slot->file->open()) {
+        qCritical("ItemSpill::item(): Couldn't open the spill file.");
+        Q_ASSERT(false);
+        return nullptr;
+    }
+    const QByteArray& blob = _slot->file->readAll();
+    _slot->file->close();
+
+    // Deserialize
+    std::shared_ptr<Items::Item> item;
+    try {
+        std::istringstream stream(blob.toStdString());
+        boost::archive::binary_iarchive ia(stream, boost::archive::archive_flags::no_header);
+        ia >> boost::serialization::make_nvp("item", item);
+    }
+    catch (const std::exception& e) {
+        qCritical("ItemSpill::item(): Couldn't deserialize the spilled item: %s", e.what());
+        Q_ASSERT(false);
+        return nullptr;
+    }
+    if (!item) {
+        qCritical("ItemSpill::item(): The spill file didn't contain an item.");
+        Q_ASSERT(false);
+        return nullptr;
+    }
+
+    // Only drop the file once the item is back
+    _slot->item = std::move(item);
+    _slot->file.reset();
+    registry().insert(_slot->item.get(), _slot);
+
+    return _slot->item;
+}
+
+const Items::Item*
+ItemSpill::peek() const
+{
+    return _slot ? _slot->item.get() : nullptr;
+}
+
+bool
+ItemSpill::spill()
+{
+    // Sanity check
+    if (!_slot || !_slot->item || _slot->file)
+        return false;
+
+    // Only the slot may hold the item, everyone else would keep it alive anyway
+    if (_slot->item.use_count() != 1)
+        return false;
+
+    // Commands referencing the item (or its children) would lose it
+    if (isPinned(_slot->item.get()))
+        return false;
+
+    // Serialize
+    std::ostringstream stream;
+    try {
+        boost::archive::binary_oarchive oa(stream, boost::archive::archive_flags::no_header);
+        oa << boost::serialization::make_nvp("item", _slot->item);
+    }
+    catch (const std::exception&) {
+        // Not exported
+        return false;
+    }
+
+    // Write
+    auto file = std::make_unique<QTemporaryFile>();
+    if (!file->open())
+        return false;
+    const std::string& blob = stream.str();
+    if (file->write(blob.data(), static_cast<qint64>(blob.size())) != static_cast<qint64>(blob.size()))
+        return false;
+    file->close();
+
+    registry().remove(_slot->item.get());
+    _slot->file = std::move(file);
+    _slot->item.reset();
+
+    return true;
+}
+
+bool
+ItemSpill::isSpilled() const
+{
+    return _slot && _slot->file;
+}
+
+std::size_t
+ItemSpill::footprint(const Items::Item* item)
+{
+    if (!item)
+        return 0;
+
+    std::size_t bytes = ITEM_FOOTPRINT_ESTIMATE;
+    QList<QGraphicsItem*> children = item->childItems();
+    while (!children.isEmpty()) {
+        const QGraphicsItem* child = children.takeLast();
+        children << child->childItems();
+        bytes += ITEM_FOOTPRINT_ESTIMATE;
+    }
+
+    return bytes;
+}
+
+ItemPin::ItemPin(const QGraphicsItem* item) :
+    _item(item)
+{
+    if (_item)
+        ItemSpill::pins()[_item]++;
+}
+
+ItemPin::ItemPin(const ItemPin& other) :
+    ItemPin(other._item)
+{
+}
+
+ItemPin::~ItemPin()
+{
+    release();
+}
+
+ItemPin&
+ItemPin::operator=(const ItemPin& rhs)
+{
+    if (rhs._item)
+        ItemSpill::pins()[rhs._item]++;
+    release();
+    _item = rhs._item;
+
+    return *this;
+}
+
+void
+ItemPin::release()
+{
+    if (!_item)
+        return;
+
+    auto& pinned = ItemSpill::pins();
+    auto it = pinned.find(_item);
+    if (it != pinned.end() && --it.value() <= 0)
+        pinned.erase(it);
+    _item = nullptr;
+}
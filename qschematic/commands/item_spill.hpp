@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QHash>
+#include <QTemporaryFile>
+
+#include <cstddef>
+#include <memory>
+
+class QGraphicsItem;
+
+namespace QSchematic::Items
+{
+    class Item;
+}
+
+namespace QSchematic::Commands
+{
+
+    /**
+     * Holds an item of a command and moves it to disk and back.
+     *
+     * @details Commands holding items which are not part of the scene (eg. a removed item) use this to release the
+     *          memory of the item while they're far down the undo stack. The item (including its children) is
+     *          serialized into a temporary file using the regular Boost serialization and deserialized again once
+     *          the command gets undone/redone.
+     *          All ItemSpill instances created for the same item share a single slot. An item which is only referenced
+     *          by commands (eg. by an ItemAdd and the ItemRemove undoing it) can therefore be spilled by whichever of
+     *          them gets compacted first, and all of them get the same item back.
+     *
+     * @note Only items which are exported to Boost can be spilled.
+     */
+    class ItemSpill
+    {
+    public:
+        ItemSpill() = default;
+        explicit
+        ItemSpill(const std::shared_ptr<Items::Item>& item);
+
+        /**
+         * Get the item.
+         *
+         * @details If the item was spilled it is read back from disk first. The file is kept until the item was
+         *          deserialized successfully.
+         *
+         * @return The item or `nullptr` if there is none or it couldn't be read back.
+         */
+        [[nodiscard]]
+        std::shared_ptr<Items::Item>
+        item();
+
+        /**
+         * Get the item without reading it back from disk.
+         *
+         * @return The item or `nullptr` if it is spilled.
+         */
+        [[nodiscard]]
+        const Items::Item*
+        peek() const;
+
+        /**
+         * Write the item to disk & release it.
+         *
+         * @details This does nothing if anyone other than the commands sharing this item holds a reference to the
+         *          item as that would neither free any memory nor preserve the identity of the item. This includes
+         *          commands referencing the item or any of its children through an ItemPin.
+         *
+         * @return Success indicator.
+         */
+        bool
+        spill();
+
+        [[nodiscard]]
+        bool
+        isSpilled() const;
+
+        /**
+         * Estimate the memory held by an item including its children.
+         *
+         * @param item The item. May be `nullptr`.
+         * @return The number of bytes.
+         */
+        [[nodiscard]]
+        static
+        std::size_t
+        footprint(const Items::Item* item);
+
+    private:
+        friend class ItemPin;
+
+        struct Slot;
+
+        /**
+         * The number of pins of each pinned item.
+         */
+        static
+        QHash<const QGraphicsItem*, int>&
+        pins();
+
+        /**
+         * Check whether an item or any of its children is pinned.
+         */
+        [[nodiscard]]
+        static
+        bool
+        isPinned(const QGraphicsItem* item);
+
+        /**
+         * The slots of all items which are currently in memory.
+         *
+         * @note Spilled items are not part of this as their address may get reused by another item.
+         */
+        static
+        QHash<const Items::Item*, std::weak_ptr<Slot>>&
+        registry();
+
+        std::shared_ptr<Slot> _slot;
+    };
+
+    /**
+     * Keeps an item from being spilled by an ItemSpill.
+     *
+     * @details Spilling an item replaces it by a new instance once it's read back. Commands referencing an item (or
+     *          one of its children) other than through an ItemSpill hold one of these so that their reference stays
+     *          valid for as long as the command exists.
+     */
+    class ItemPin
+    {
+    public:
+        ItemPin() = default;
+        explicit
+        ItemPin(const QGraphicsItem* item);
+        ItemPin(const ItemPin& other);
+        ~ItemPin();
+
+        ItemPin&
+        operator=(const ItemPin& rhs);
+
+    private:
+        void
+        release();
+
+        const QGraphicsItem* _item = nullptr;
+    };
+
+}
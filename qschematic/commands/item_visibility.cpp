@@ -8,6 +8,7 @@ using namespace QSchematic::Commands;
 ItemVisibility::ItemVisibility(const std::shared_ptr<Items::Item>& item, bool newVisibility, QUndoCommand* parent) :
     Base(parent),
     _item(item),
+    _pin(item.get()),
     _newVisibility(newVisibility)
 {
     _oldVisibility = _item->isVisible();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <memory>
 
@@ -27,6 +28,7 @@ namespace QSchematic::Commands
 
     private:
         std::shared_ptr<Items::Item> _item;
+        ItemPin _pin;           // Keeps the parents of the item from being spilled
         bool _oldVisibility;
         bool _newVisibility;
     };
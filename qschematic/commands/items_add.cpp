@@ -0,0 +1,288 @@
+#include "commands.hpp"
+#include "items_add.hpp"
+#include "../items/connector.hpp"
+#include "../items/item.hpp"
+#include "../items/node.hpp"
+#include "../items/wire.hpp"
+#include "../items/wirenet.hpp"
+#include "../scene.hpp"
+
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+
+using namespace QSchematic;
+using namespace QSchematic::Commands;
+
+namespace
+{
+
+    /**
+     * A wire point that can be attached to a connector.
+     */
+    struct WireEnd
+    {
+        wire_system::wire* wire = nullptr;
+        int index = -1;
+    };
+
+    [[nodiscard]]
+    quint64
+    pointKey(const QPoint& point)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(point.x())) << 32) | static_cast<quint32>(point.y());
+    }
+
+    void
+    insertEnds(QHash<quint64, WireEnd>& ends, wire_system::wire* wire)
+    {
+        const auto& points = wire->points();
+        if (points.isEmpty())
+            return;
+
+        // The first wire ending at a point wins, like with manager::wire_with_extremity_at()
+        const int lastIndex = points.count() - 1;
+        if (!points.first().is_junction() && !ends.contains(pointKey(points.first().toPoint())))
+            ends.insert(pointKey(points.first().toPoint()), { wire, 0 });
+        if (!points.last().is_junction() && !ends.contains(pointKey(points.last().toPoint())))
+            ends.insert(pointKey(points.last().toPoint()), { wire, lastIndex });
+    }
+
+}
+
+ItemsAdd::ItemsAdd(
+    const QPointer<Scene>& scene,
+    std::vector<std::shared_ptr<Items::Item>> items,
+    std::vector<std::shared_ptr<Items::Wire>> wires,
+    QUndoCommand* parent
+) :
+    Base(parent),
+    _scene(scene),
+    _items(std::move(items)),
+    _wires(std::move(wires))
+{
+    connectDependencyDestroySignal(_scene.data());
+    setText(tr("Add items"));
+
+    // Remember the nets as connecting the wires merges them into the existing ones
+    _nets.reserve(_wires.size());
+    for (const auto& wire : _wires)
+        _nets.push_back(wire->net());
+}
+
+int
+ItemsAdd::id() const
+{
+    return ItemsAddCommandType;
+}
+
+bool
+ItemsAdd::mergeWith(const QUndoCommand* command)
+{
+    Q_UNUSED(command)
+
+    return false;
+}
+
+void
+ItemsAdd::undo()
+{
+    if (!_scene)
+        return;
+
+    // Detach the connectors this command attached
+    for (const auto& connector : _attachedConnectors)
+        _scene->wire_manager()->detach_wire(connector);
+    _attachedConnectors.clear();
+
+    for (const auto& wire : _wires)
+        _scene->removeWire(wire);
+
+    for (const auto& item : _items)
+        _scene->removeItem(item);
+
+    // Split the existing nets that got merged through the added wires
+    restoreNets();
+}
+
+void
+ItemsAdd::redo()
+{
+    if (!_scene)
+        return;
+
+    // Items
+    for (const auto& item : _items)
+        _scene->addItem(item);
+
+    // Wires
+    for (std::size_t i = 0; i < _wires.size(); i++) {
+        const auto& wire = _wires[i];
+        const auto& net = _nets[i];
+        if (!net)
+            continue;
+
+        if (!_scene->wire_manager()->nets().contains(net)) {
+            if (auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net))
+                wireNet->setScene(_scene);
+            _scene->wire_manager()->add_net(net);
+        }
+
+        net->addWire(wire);
+        _scene->addItem(wire);
+    }
+
+    // Connect everything once
+    connectAdded();
+}
+
+/**
+ * Attaches the added connectors & wires and generates the junctions of the added wires.
+ *
+ * @details Pairs of existing connectors & wires are left alone, they were already connected before.
+ */
+void
+ItemsAdd::connectAdded()
+{
+    auto manager = _scene->wire_manager();
+
+    QSet<const wire_system::wire*> addedWires;
+    addedWires.reserve(static_cast<int>(_wires.size()));
+    for (const auto& wire : _wires)
+        addedWires.insert(wire.get());
+
+    // Wire ends to attach the connectors to
+    const auto& wires = manager->wires();
+    QHash<quint64, WireEnd> addedEnds;
+    QHash<quint64, WireEnd> allEnds;
+    allEnds.reserve(wires.count() * 2);
+    for (const auto& wire : _wires)
+        insertEnds(addedEnds, wire.get());
+    for (const auto& wire : wires)
+        insertEnds(allEnds, wire.get());
+
+    // Added connectors may attach to any wire
+    QSet<const wire_system::connectable*> addedConnectors;
+    for (const auto& item : _items) {
+        const auto node = std::dynamic_pointer_cast<Items::Node>(item);
+        if (!node)
+            continue;
+
+        for (const auto& connector : node->connectors()) {
+            addedConnectors.insert(connector.get());
+            if (!connector->isVisible() || manager->attached_wire(connector.get()))
+                continue;
+
+            const auto it = allEnds.constFind(pointKey(connector->scenePos().toPoint()));
+            if (it == allEnds.constEnd())
+                continue;
+
+            manager->attach_wire_to_connector(it->wire, it->index, connector.get());
+            _attachedConnectors.push_back(connector.get());
+        }
+    }
+
+    // Existing connectors may only attach to the added wires
+    if (!addedEnds.isEmpty()) {
+        for (const auto& connector : _scene->connectors()) {
+            if (addedConnectors.contains(connector.get()))
+                continue;
+            if (!connector->isVisible() || manager->attached_wire(connector.get()))
+                continue;
+
+            const auto it = addedEnds.constFind(pointKey(connector->scenePos().toPoint()));
+            if (it == addedEnds.constEnd())
+                continue;
+
+            manager->attach_wire_to_connector(it->wire, it->index, connector.get());
+            _attachedConnectors.push_back(connector.get());
+        }
+    }
+
+    // Remember the existing nets before they get merged
+    _mergedNets.clear();
+    QSet<const wire_system::net*> recordedNets;
+    const auto recordNet = [&](wire_system::wire* wire) {
+        auto net = wire->net();
+        if (!net || recordedNets.contains(net.get()))
+            return;
+        if (std::find(_nets.cbegin(), _nets.cend(), net) != _nets.cend())
+            return;
+
+        recordedNets.insert(net.get());
+        _mergedNets.emplace_back(net, net->wires());
+    };
+    const auto connectWire = [&](wire_system::wire* wire, wire_system::wire* rawWire, int index) {
+        if (wire->connected_wires_ref().contains(rawWire))
+            return;
+
+        recordNet(wire);
+        recordNet(rawWire);
+        manager->connect_wire(wire, rawWire, index);
+    };
+
+    // Junctions involving at least one added wire
+    for (const auto& addedWire : _wires) {
+        if (addedWire->points_count() < 2)
+            continue;
+
+        const QPointF first = addedWire->points().first().toPointF();
+        const QPointF last = addedWire->points().last().toPointF();
+        const int lastIndex = addedWire->points_count() - 1;
+
+        for (const auto& wire : wires) {
+            if (wire.get() == addedWire.get() || wire->points_count() < 2)
+                continue;
+
+            // Ends of the added wire on the other wire
+            if (wire->point_is_on_wire(first))
+                connectWire(wire.get(), addedWire.get(), 0);
+            if (wire->point_is_on_wire(last))
+                connectWire(wire.get(), addedWire.get(), lastIndex);
+
+            // Ends of an existing wire on the added wire (pairs of added wires are handled from both sides already)
+            if (addedWires.contains(wire.get()))
+                continue;
+            if (addedWire->point_is_on_wire(wire->points().first().toPointF()))
+                connectWire(addedWire.get(), wire.get(), 0);
+            if (addedWire->point_is_on_wire(wire->points().last().toPointF()))
+                connectWire(addedWire.get(), wire.get(), wire->points_count() - 1);
+        }
+    }
+
+    Q_EMIT _scene->netlistChanged();
+}
+
+/**
+ * Puts the wires of the existing nets that got merged by connectAdded() back into their original nets.
+ */
+void
+ItemsAdd::restoreNets()
+{
+    auto manager = _scene->wire_manager();
+
+    for (const auto& [net, wires] : _mergedNets) {
+        if (!manager->nets().contains(net))
+            manager->add_net(net);
+
+        for (const auto& wire : wires) {
+            auto currentNet = wire->net();
+            if (currentNet == net)
+                continue;
+
+            if (currentNet)
+                currentNet->removeWire(wire);
+            net->addWire(wire);
+        }
+    }
+    _mergedNets.clear();
+
+    // Drop the nets that were created while splitting & are empty now
+    for (const auto& net : manager->nets()) {
+        if (net->wires().isEmpty())
+            manager->remove_net(net);
+    }
+
+    Q_EMIT _scene->netlistChanged();
+}
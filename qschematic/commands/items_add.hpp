@@ -0,0 +1,70 @@
+#pragma once
+
+#include "base.hpp"
+
+#include <QPointer>
+
+#include <QList>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace QSchematic
+{
+    class Scene;
+}
+
+namespace QSchematic::Items
+{
+    class Item;
+    class Wire;
+}
+
+namespace wire_system
+{
+    class connectable;
+    class net;
+    class wire;
+}
+
+namespace QSchematic::Commands
+{
+
+    /**
+     * Adds several items & wires as one command.
+     *
+     * @details Unlike a series of ItemAdd commands, the wires get connected to the connectors and the junctions get
+     *          generated once after everything has been added. Only the connectors & wires added by this command are
+     *          considered, so the cost is linear in the size of the scene instead of quadratic. Everything this command
+     *          attached to or merged with the existing connectors, wires & nets is recorded and reverted on undo.
+     */
+    class ItemsAdd :
+        public Base
+    {
+    public:
+        ItemsAdd(
+            const QPointer<Scene>& scene,
+            std::vector<std::shared_ptr<Items::Item>> items,
+            std::vector<std::shared_ptr<Items::Wire>> wires,
+            QUndoCommand* parent = nullptr
+        );
+
+        int id() const override;
+        bool mergeWith(const QUndoCommand* command) override;
+        void undo() override;
+        void redo() override;
+
+    private:
+        void connectAdded();
+        void restoreNets();
+
+        QPointer<Scene> _scene;
+        std::vector<std::shared_ptr<Items::Item>> _items;
+        std::vector<std::shared_ptr<Items::Wire>> _wires;   // Wires need to belong to a net
+        std::vector<std::shared_ptr<wire_system::net>> _nets;   // The net of each wire at construction
+        std::vector<const wire_system::connectable*> _attachedConnectors;
+        std::vector<std::pair<std::shared_ptr<wire_system::net>, QList<std::shared_ptr<wire_system::wire>>>> _mergedNets;  // Existing nets & their wires before being merged
+    };
+
+}
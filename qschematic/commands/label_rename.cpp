@@ -8,6 +8,7 @@ using namespace QSchematic::Commands;
 LabelRename::LabelRename(const QPointer<Items::Label>& label, const QString& newText, QUndoCommand* parent) :
     Base(parent),
     _label(label),
+    _pin(label.data()),
     _newText(newText)
 {
     _oldText = _label->text();
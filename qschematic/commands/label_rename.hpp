@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <QPointer>
 
@@ -25,6 +26,7 @@ namespace QSchematic::Commands
 
     private:
         QPointer<Items::Label> _label;
+        ItemPin _pin;           // Keeps the label (and thereby its parents) from being spilled
         QString _oldText;
         QString _newText;
     };
@@ -8,6 +8,7 @@ using namespace QSchematic::Commands;
 RectItemResize::RectItemResize(QPointer<Items::RectItem> item, const QPointF& newPos, const QSizeF& newSize, QUndoCommand* parent) :
     Base(parent),
     _item(item),
+    _pin(item.data()),
     _newPos(newPos),
     _newSize(newSize)
 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.hpp"
+#include "item_spill.hpp"
 
 #include <QPointer>
 #include <QPoint>
@@ -27,6 +28,7 @@ namespace QSchematic::Commands
 
     private:
         QPointer<Items::RectItem> _item;
+        ItemPin _pin;           // Keeps the item from being spilled
         QPointF _oldPos;
         QPointF _newPos;
         QSizeF _oldSize;
@@ -10,6 +10,7 @@ using namespace QSchematic::Commands;
 RectItemRotate::RectItemRotate(QPointer<Items::RectItem> item, qreal newAngle, QUndoCommand* parent) :
     Base(parent),
     _item(item),
+    _pin(item.data()),
     _newAngle(newAngle)
 {
     _oldAngle = item->rotation();
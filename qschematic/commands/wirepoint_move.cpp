@@ -3,9 +3,17 @@
 #include "../scene.hpp"
 #include "../items/item.hpp"
 
+#include <QDataStream>
+#include <QTemporaryFile>
+
+#include <algorithm>
+
 using namespace QSchematic;
 using namespace QSchematic::Commands;
 
+// Minimum number of point changes for which compacting writes them to a temporary file
+const int SPILL_MIN_CHANGES = 64;
+
 WirepointMove::WirepointMove(
     Scene* scene,
     const std::shared_ptr<Items::Wire>& wire,
@@ -17,15 +25,18 @@ WirepointMove::WirepointMove(
     _scene(scene),
     _wire(wire)
 {
-    _oldPos = _wire->pointsAbsolute();
-    if (_oldPos[index] == pos)
+    _oldPointCount = _wire->points_count();
+    const QPointF& oldPos = _wire->pointsAbsolute().at(index);
+    if (oldPos == pos)
         setObsolete(true);
-    _newPos = _wire->pointsAbsolute();
-    _newPos[index] = pos;
+    else
+        _changes.append({ index, oldPos, pos });
     _oldNet = _wire->net();
     setText(tr("Move wire point"));
 }
 
+WirepointMove::~WirepointMove() = default;
+
 int
 WirepointMove::id() const
 {
@@ -44,10 +55,28 @@ WirepointMove::mergeWith(const QUndoCommand* command)
     if (_wire != myCommand->_wire)
         return false;
 
-    _newPos = myCommand->_newPos;
+    // This is never the case for the most recent command but be safe
+    if (!restore())
+        return false;
+
+    // Merge the changes
+    for (const PointChange& change : myCommand->_changes) {
+        auto it = std::find_if(_changes.begin(), _changes.end(), [&change](const PointChange& existing) {
+            return existing.index == change.index;
+        });
+        if (it != _changes.end())
+            it->newPos = change.newPos;
+        else
+            _changes.append(change);
+    }
     _newNet = myCommand->_newNet;
 
-    if (_oldPos == _newPos)
+    // Drop the points which are back at their original position
+    _changes.erase(std::remove_if(_changes.begin(), _changes.end(), [](const PointChange& change) {
+        return change.oldPos == change.newPos;
+    }), _changes.end());
+
+    if (_changes.isEmpty())
         setObsolete(true);
 
     return true;
@@ -56,13 +85,16 @@ WirepointMove::mergeWith(const QUndoCommand* command)
 void
 WirepointMove::undo()
 {
+    if (!restore())
+        return;
+
     _newNet = _wire->net();
     // The wire might get simplified after this action is executed. In most
     // cases the wire should be back to the state it was before this command
     // but there are cases were we can't rely on the other commands so we need
     // to make sure that we have the correct amount of points.
-    if (_oldPos.count() != _wire->wirePointsRelative().count()) {
-        int diff = _oldPos.count() - _wire->wirePointsRelative().count();
+    if (_oldPointCount != _wire->wirePointsRelative().count()) {
+        int diff = _oldPointCount - _wire->wirePointsRelative().count();
         if (diff > 0) {
             for (int i = 0; i < diff; i++) {
                 _wire->append_point(QPointF());
@@ -74,11 +106,9 @@ WirepointMove::undo()
         }
     }
 
-    for (int i = 0; i < _oldPos.count(); i++) {
-        if (_newPos[i] != _oldPos[i]) {
-            _wire->move_point_to(i, _oldPos[i]);
-            _scene->wire_manager()->point_moved_by_user(*_wire.get(), i);
-        }
+    for (const PointChange& change : _changes) {
+        _wire->move_point_to(change.index, change.oldPos);
+        _scene->wire_manager()->point_moved_by_user(*_wire.get(), change.index);
     }
     if (_oldNet != _wire->net()) {
         auto tmpNet = _wire->net();
@@ -98,11 +128,12 @@ WirepointMove::undo()
 void
 WirepointMove::redo()
 {
-    for (int i = 0; i < _newPos.count(); i++) {
-        if (_newPos[i] != _oldPos[i]) {
-            _wire->move_point_to(i, _newPos[i]);
-            _scene->wire_manager()->point_moved_by_user(*_wire.get(), i);
-        }
+    if (!restore())
+        return;
+
+    for (const PointChange& change : _changes) {
+        _wire->move_point_to(change.index, change.newPos);
+        _scene->wire_manager()->point_moved_by_user(*_wire.get(), change.index);
     }
     // Use existing net
     if (_newNet && _newNet != _wire->net()) {
@@ -123,3 +154,77 @@ WirepointMove::redo()
         _newNet = _wire->net();
     }
 }
+
+std::size_t
+WirepointMove::memoryFootprint() const
+{
+    return sizeof(*this) + std::size_t(_changes.capacity()) * sizeof(PointChange);
+}
+
+void
+WirepointMove::compact()
+{
+    // Not worth a file
+    if (_spillFile || _changes.size() < SPILL_MIN_CHANGES) {
+        _changes.squeeze();
+        return;
+    }
+
+    // Write
+    auto file = std::make_unique<QTemporaryFile>();
+    if (!file->open()) {
+        _changes.squeeze();
+        return;
+    }
+    {
+        QDataStream stream(file.get());
+        stream << static_cast<qint32>(_changes.size());
+        for (const PointChange& change : _changes)
+            stream << change.index << change.oldPos << change.newPos;
+        if (stream.status() != QDataStream::Ok) {
+            _changes.squeeze();
+            return;
+        }
+    }
+    file->close();
+
+    _spillFile = std::move(file);
+    _changes = { };
+}
+
+bool
+WirepointMove::restore()
+{
+    if (!_spillFile)
+        return true;
+
+    // Read. Keep the file until the changes were read successfully.
+    if (!_spillFile->open()) {
+        qCritical("WirepointMove::restore(): Couldn't open the spill file.");
+        Q_ASSERT(false);
+        return false;
+    }
+    QVector<PointChange> changes;
+    {
+        QDataStream stream(_spillFile.get());
+        qint32 count = 0;
+        stream >> count;
+        changes.reserve(count);
+        for (int i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+            PointChange change;
+            stream >> change.index >> change.oldPos >> change.newPos;
+            changes.append(change);
+        }
+        if (stream.status() != QDataStream::Ok) {
+            qCritical("WirepointMove::restore(): Couldn't read the spilled point changes.");
+            Q_ASSERT(false);
+            _spillFile->close();
+            return false;
+        }
+    }
+
+    _changes = std::move(changes);
+    _spillFile.reset();
+
+    return true;
+}
@@ -9,10 +9,18 @@
 #include <memory>
 
 class QVector2D;
+class QTemporaryFile;
 
 namespace QSchematic::Commands
 {
 
+    /**
+     * Moves a point of a wire.
+     *
+     * @details Only the indices & positions of the points that actually changed are stored rather than copies of all
+     *          the points of the wire. When compacted, large sets of changes are written to a temporary file and
+     *          read back when the command gets undone or redone.
+     */
     class WirepointMove :
         public Base
     {
@@ -24,16 +32,29 @@ namespace QSchematic::Commands
             const QPointF& pos,
             QUndoCommand* parent = nullptr
         );
+        ~WirepointMove() override;
 
         int id() const override;
         bool mergeWith(const QUndoCommand* command) override;
         void undo() override;
         void redo() override;
+        std::size_t memoryFootprint() const override;
+        void compact() override;
 
     private:
+        bool restore();
+
+        struct PointChange
+        {
+            int index;
+            QPointF oldPos;     // Absolute
+            QPointF newPos;     // Absolute
+        };
+
         std::shared_ptr<Items::Wire> _wire;
-        QVector<QPointF> _oldPos;
-        QVector<QPointF> _newPos;
+        int _oldPointCount;
+        QVector<PointChange> _changes;
+        std::unique_ptr<QTemporaryFile> _spillFile;     // Holds the changes while compacted
         std::shared_ptr<net> _oldNet;
         std::shared_ptr<net> _newNet;
         Scene* _scene;
@@ -6,6 +6,7 @@
 #include "../utils.hpp"
 
 #include <QtMath>
+#include <QDataStream>
 #include <QPainter>
 #include <QTransform>
 #include <QVector2D>
@@ -31,9 +32,11 @@ Connector::Connector(int type, const QPoint& gridPoint, const QString& text, QGr
     _textDirection(TextDirection::LeftToRight)
 {
     // Label
-    _label = std::make_shared<Label>();
-    _label->setParentItem(this);
-    _label->setText(text);
+    // Most connectors never show a label so it's only created once there's text to show.
+    if (!text.isEmpty()) {
+        createLabel();
+        _label->setText(text);
+    }
 
     // Flags
     setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
@@ -56,7 +59,9 @@ Connector::Connector(int type, const QPoint& gridPoint, const QString& text, QGr
 Connector::~Connector()
 {
     // So it's definitely removed via the shared_ptr (which we have by way of the item-allocation contracts being shptr all through
-    dissociate_item(_label);
+    if (_label) {
+        dissociate_item(_label);
+    }
 
     // Disconnect all wires
     disconnect_all_wires();
@@ -88,13 +93,18 @@ void Connector::load(Archive& ar, const unsigned int version)
     ar & boost::serialization::make_nvp("snap_policy", _snapPolicy);
     ar & boost::serialization::make_nvp("force_text_direction", _forceTextDirection);
     ar & boost::serialization::make_nvp("text_direction", _textDirection);
+    if (_label) {
+        dissociate_item(_label);
+    }
     ar & boost::serialization::make_nvp("label", _label);
-    _label->setParentItem(this);
+    if (_label) {
+        _label->setParentItem(this);
+    }
 }
 
 std::shared_ptr<Item> Connector::deepCopy() const
 {
-    auto clone = std::make_shared<Connector>(type(), gridPos(), text(), parentItem());
+    auto clone = std::make_shared<Connector>(type(), gridPos(), QString(), parentItem());
     copyAttributes(*clone);
 
     return clone;
@@ -102,14 +112,18 @@ std::shared_ptr<Item> Connector::deepCopy() const
 
 void Connector::copyAttributes(Connector& dest) const
 {
-    Q_ASSERT(_label);
-
     // Base class
     Item::copyAttributes(dest);
 
     // Label
-    dest._label = std::dynamic_pointer_cast<Label>(_label->deepCopy());
-    dest._label->setParentItem(&dest);
+    if (dest._label) {
+        dissociate_item(dest._label);
+        dest._label.reset();
+    }
+    if (_label) {
+        dest._label = std::dynamic_pointer_cast<Label>(_label->deepCopy());
+        dest._label->setParentItem(&dest);
+    }
 
     // Attributes
     dest._snapPolicy = _snapPolicy;
@@ -130,14 +144,18 @@ Connector::SnapPolicy Connector::snapPolicy() const
 
 void Connector::setText(const QString& text)
 {
-    _label->setText(text);
+    if (!_label && text.isEmpty()) {
+        return;
+    }
+
+    ensureLabel()->setText(text);
 
     calculateTextDirection();
 }
 
 QString Connector::text() const
 {
-    return _label->text();
+    return _label ? _label->text() : QString();
 }
 
 void Connector::setForceTextDirection(bool enabled)
@@ -194,12 +212,30 @@ QRectF Connector::boundingRect() const
 {
     qreal adj = qCeil(PEN_WIDTH / 2.0);
     if (isHighlighted()) {
-        adj += _settings.highlightRectPadding;
+        adj += _settings->highlightRectPadding;
     }
 
     return _symbolRect.adjusted(-adj, -adj, adj, adj);
 }
 
+QGraphicsItem::CacheMode Connector::cacheModePolicy() const
+{
+    return static_cast<QGraphicsItem::CacheMode>(_settings->cacheModeConnector);
+}
+
+bool Connector::pixmapCacheable() const
+{
+    // Subclasses may paint more than the attributes cover
+    return type() == Item::ConnectorType;
+}
+
+void Connector::pixmapCacheAttributes(QDataStream& stream) const
+{
+    Item::pixmapCacheAttributes(stream);
+
+    stream << _symbolRect;
+}
+
 QVariant Connector::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value)
 {
     switch (change) {
@@ -231,7 +267,7 @@ QVariant Connector::itemChange(QGraphicsItem::GraphicsItemChange change, const Q
 
         // Honor snap-to-grid
         if (parentNode->canSnapToGrid() && snapToGrid()) {
-            proposedPos = _settings.snapToGrid(proposedPos);
+            proposedPos = _settings->snapToGrid(proposedPos);
         }
 
         return proposedPos;
@@ -267,16 +303,19 @@ QVariant Connector::itemChange(QGraphicsItem::GraphicsItemChange change, const Q
 
 void Connector::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    Item::paint(painter, option, widget);
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
     }
 
+    // Skip the symbol if it would be too small to be recognizable
+    if (levelOfDetail(*painter, option) < _settings->lodMinScaleSymbols)
+        return;
+
     // Body pen
     QPen bodyPen;
     bodyPen.setWidthF(PEN_WIDTH);
@@ -291,16 +330,53 @@ void Connector::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     // Draw the component body
     painter->setPen(bodyPen);
     painter->setBrush(bodyBrush);
-    painter->drawRoundedRect(_symbolRect, _settings.gridSize/4, _settings.gridSize/4);
+    painter->drawRoundedRect(_symbolRect, _settings->gridSize/4, _settings->gridSize/4);
 }
 
+/**
+ * Get the label of this connector.
+ *
+ * @note Labels are only created once they're needed. Use ensureLabel() to get a label in any case.
+ *
+ * @return The label or nullptr if there is none (yet).
+ */
 std::shared_ptr<Label> Connector::label() const
 {
     return _label;
 }
 
+/**
+ * Get the label of this connector, creating it if it doesn't exist yet.
+ *
+ * @return The label.
+ */
+std::shared_ptr<Label> Connector::ensureLabel()
+{
+    if (!_label) {
+        createLabel();
+    }
+
+    return _label;
+}
+
+bool Connector::hasLabel() const
+{
+    return _label != nullptr;
+}
+
+void Connector::createLabel()
+{
+    _label = std::make_shared<Label>();
+    _label->setParentItem(this);
+    alignLabel();
+}
+
 void Connector::alignLabel()
 {
+    if (!_label) {
+        return;
+    }
+
     QPointF labelNewPos = _label->pos();
     QTransform t;
     const QRectF& textRect = _label->textRect();
@@ -337,7 +413,7 @@ void Connector::alignLabel()
 
 void Connector::calculateSymbolRect()
 {
-    _symbolRect = QRectF(-SIZE*_settings.gridSize/2.0, -SIZE*_settings.gridSize/2.0, SIZE*_settings.gridSize, SIZE*_settings.gridSize);
+    _symbolRect = QRectF(-SIZE*_settings->gridSize/2.0, -SIZE*_settings->gridSize/2.0, SIZE*_settings->gridSize, SIZE*_settings->gridSize);
 }
 
 void Connector::calculateTextDirection()
@@ -55,6 +55,8 @@ namespace QSchematic::Items
 
         QPointF connectionPoint() const;
         std::shared_ptr<Label> label() const;
+        std::shared_ptr<Label> ensureLabel();
+        bool hasLabel() const;
         void alignLabel();
         QRectF boundingRect() const override;
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
@@ -65,8 +67,12 @@ namespace QSchematic::Items
     protected:
         void copyAttributes(Connector& dest) const;
         QVariant itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value) override;
+        QGraphicsItem::CacheMode cacheModePolicy() const override;
+        bool pixmapCacheable() const override;
+        void pixmapCacheAttributes(QDataStream& stream) const override;
 
     private:
+        void createLabel();
         void calculateSymbolRect();
         void calculateTextDirection();
         void disconnect_all_wires();
@@ -76,7 +82,7 @@ namespace QSchematic::Items
         QRectF _symbolRect;
         bool _forceTextDirection;
         TextDirection _textDirection;
-        std::shared_ptr<Label> _label;
+        std::shared_ptr<Label> _label;      // Created on first use
     };
 
 }
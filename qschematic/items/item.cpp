@@ -1,6 +1,7 @@
 #include "item.hpp"
 #include "../scene.hpp"
 #include "../commands/item_move.hpp"
+#include "../utils/pixmapcache.hpp"
 
 #include <QDebug>
 #include <QPainter>
@@ -8,10 +9,19 @@
 #include <QGraphicsSceneHoverEvent>
 #include <QStyleOptionGraphicsItem>
 #include <QWidget>
+#include <QCryptographicHash>
+#include <QDataStream>
 
 using namespace QSchematic;
 using namespace QSchematic::Items;
 
+// Salt of the pixmap cache keys. Bump this whenever the painting of the built-in items changes so that pixmaps
+// persisted by a previous version aren't reused.
+const int PIXMAP_CACHE_KEY_VERSION = 1;
+
+// Number of items painted since the counter was last reset
+static int paintedItems = 0;
+
 Item::Item(int type, QGraphicsItem* parent) :
     QGraphicsObject(parent),
     _type(type),
@@ -126,7 +136,7 @@ int Item::type() const
 
 void Item::setGridPos(const QPoint& gridPos)
 {
-    setPos(_settings.toScenePoint(gridPos));
+    setPos(_settings->toScenePoint(gridPos));
 }
 
 void Item::setGridPos(int x, int y)
@@ -146,7 +156,7 @@ void Item::setGridPosY(int y)
 
 QPoint Item::gridPos() const
 {
-    return _settings.toGridPoint(pos().toPoint());
+    return _settings->toGridPoint(pos().toPoint());
 }
 
 int Item::gridPosX() const
@@ -235,15 +245,23 @@ void Item::moveBy(const QVector2D& moveBy)
 }
 
 void Item::setSettings(const Settings& settings)
+{
+    setSettings(SharedSettings(settings));
+}
+
+void Item::setSettings(const SharedSettings& settings)
 {
     // Resnap to grid
     if (snapToGrid()) {
-        setPos(_settings.snapToGrid(pos()));
+        setPos(_settings->snapToGrid(pos()));
     }
 
     // Store the new settings
     _settings = settings;
 
+    // Cache mode
+    setCacheMode(cacheModePolicy());
+
     // Let everyone know
     Q_EMIT settingsChanged();
 
@@ -253,7 +271,7 @@ void Item::setSettings(const Settings& settings)
 
 const Settings& Item::settings() const
 {
-    return _settings;
+    return *_settings;
 }
 
 void Item::setMovable(bool enabled)
@@ -281,8 +299,49 @@ bool Item::isHighlighted() const
     return ( ( _highlighted || isSelected() ) && _highlightEnabled );
 }
 
+qreal
+Item::levelOfDetail(const QPainter& painter, const QStyleOptionGraphicsItem* option)
+{
+    if (!option)
+        return 1.0;
+
+    return option->levelOfDetailFromTransform(painter.worldTransform());
+}
+
+void
+Item::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(painter)
+    Q_UNUSED(option)
+    Q_UNUSED(widget)
+
+    paintedItems++;
+}
+
+int
+Item::paintedCount()
+{
+    return paintedItems;
+}
+
+void
+Item::resetPaintedCount()
+{
+    paintedItems = 0;
+}
+
+QGraphicsItem::CacheMode
+Item::cacheModePolicy() const
+{
+    return cacheMode();
+}
+
 void Item::setHighlighted(bool highlighted)
 {
+    // Invalidate the cache
+    if (_highlighted != highlighted)
+        update();
+
     _highlighted = highlighted;
 
     // Ripple through children
@@ -298,6 +357,8 @@ void Item::setHighlightEnabled(bool enabled)
 {
     _highlightEnabled = enabled;
     _highlighted = false;
+
+    update();
 }
 
 bool Item::highlightEnabled() const
@@ -322,14 +383,24 @@ QPixmap Item::toPixmap(QPointF& hotSpot, qreal scale)
     // Provide the hot spot
     hotSpot = -rectF.topLeft();
 
+    // Look up the cache
+    auto& cache = ItemUtils::PixmapCache::instance();
+    const QByteArray& cacheKey = cache.isEnabled() ? pixmapCacheKey(rectF.size(), scale) : QByteArray();
+    if (!cacheKey.isEmpty()) {
+        QPixmap pixmap;
+        QPointF cachedHotSpot;
+        if (cache.find(cacheKey, pixmap, cachedHotSpot))
+            return pixmap;
+    }
+
     // Create the pixmap
     QPixmap pixmap(rect.size() * scale);
     pixmap.fill(Qt::transparent);
 
     // Render
     QPainter painter(&pixmap);
-    painter.setRenderHint(QPainter::Antialiasing, _settings.antialiasing);
-    painter.setRenderHint(QPainter::TextAntialiasing, _settings.antialiasing);
+    painter.setRenderHint(QPainter::Antialiasing, _settings->antialiasing);
+    painter.setRenderHint(QPainter::TextAntialiasing, _settings->antialiasing);
     painter.scale(scale, scale);
     painter.translate(hotSpot);
     QStyleOptionGraphicsItem option;
@@ -346,9 +417,58 @@ QPixmap Item::toPixmap(QPointF& hotSpot, qreal scale)
 
     painter.end();
 
+    // Cache
+    if (!cacheKey.isEmpty())
+        cache.insert(cacheKey, pixmap, hotSpot);
+
     return pixmap;
 }
 
+bool Item::pixmapCacheable() const
+{
+    return false;
+}
+
+void Item::pixmapCacheAttributes(QDataStream& stream) const
+{
+    stream << type() << boundingRect() << isSelected() << isHighlighted() << isVisible();
+}
+
+QByteArray Item::pixmapCacheKey(const QSizeF& size, qreal scale) const
+{
+    // Only cache what the key fully describes
+    if (!pixmapCacheable())
+        return { };
+    for (const QGraphicsItem* child : childItems()) {
+        const Item* childItem = dynamic_cast<const Item*>(child);
+        if (child && (!childItem || !childItem->pixmapCacheable()))
+            return { };
+    }
+
+    QByteArray attributes;
+    {
+        QDataStream stream(&attributes, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+
+        // Render parameters
+        stream << PIXMAP_CACHE_KEY_VERSION << size << scale;
+        stream << _settings->debug << _settings->gridSize << _settings->highlightRectPadding << _settings->resizeHandleSize;
+        stream << _settings->antialiasing << _settings->lodMinScaleText << _settings->lodMinScaleSymbols << _settings->lodMinScaleDetails;
+
+        // The item & its children (as rendered by toPixmap()). The position and the Z value don't affect the result.
+        pixmapCacheAttributes(stream);
+        for (const QGraphicsItem* child : childItems()) {
+            if (!child)
+                continue;
+
+            stream << child->pos();
+            static_cast<const Item*>(child)->pixmapCacheAttributes(stream);
+        }
+    }
+
+    return QCryptographicHash::hash(attributes, QCryptographicHash::Sha1);
+}
+
 QVariant Item::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value)
 {
     switch (change)
@@ -363,7 +483,7 @@ QVariant Item::itemChange(QGraphicsItem::GraphicsItemChange change, const QVaria
     {
         QPointF newPos = value.toPointF();
         if (snapToGrid()) {
-            newPos =_settings.snapToGrid(newPos);
+            newPos =_settings->snapToGrid(newPos);
         }
         return newPos;
     }
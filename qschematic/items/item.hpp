@@ -19,6 +19,8 @@
 
 #include <memory>
 
+class QDataStream;
+
 namespace QSchematic
 {
     class Scene;
@@ -43,6 +45,7 @@ namespace QSchematic::Items
             LabelType,
             SplineWireType,
             BackgroundType,
+            WireLayerType,
 
             QSchematicItemUserType = QGraphicsItem::UserType + 100
         };
@@ -190,9 +193,29 @@ namespace QSchematic::Items
         void
         moveBy(const QVector2D& moveBy);
 
+        /**
+         * Set settings.
+         *
+         * @details This gives the item its own copy of @p settings. Prefer sharing settings via the overload taking
+         *          SharedSettings.
+         *
+         * @param settings The settings.
+         */
         void
         setSettings(const Settings& settings);
 
+        /**
+         * Share settings.
+         *
+         * @details The item keeps a reference to the shared settings. Replacing them via SharedSettings::set() is
+         *          immediately visible to the item without calling this again. However, items only react to
+         *          the change (eg. resnapping or updating their geometry) when this function gets called.
+         *
+         * @param settings The shared settings.
+         */
+        void
+        setSettings(const SharedSettings& settings);
+
         [[nodiscard]]
         const Settings&
         settings() const;
@@ -245,11 +268,12 @@ namespace QSchematic::Items
         void moved(Item& item, const QVector2D& movedBy);
         void movedInScene(Item& item);
         void rotated(Item& item, qreal rotation);
+        void geometryChanged(Item& item);
         void highlightChanged(const Item& item, bool isHighlighted);
         void settingsChanged();
 
     protected:
-        Settings _settings;
+        SharedSettings _settings;
 
         void
         copyAttributes(Item& dest) const;
@@ -258,6 +282,89 @@ namespace QSchematic::Items
         bool
         isHighlighted() const;
 
+        /**
+         * Get the level of detail at which the item is being painted.
+         *
+         * @details Items use this to compare against the `lodMinScale*` thresholds in the settings.
+         *
+         * @param painter The painter.
+         * @param option The style option passed to paint(). May be `nullptr`.
+         * @return The scale (device pixels per item unit).
+         */
+        [[nodiscard]]
+        static
+        qreal
+        levelOfDetail(const QPainter& painter, const QStyleOptionGraphicsItem* option);
+
+        /**
+         * Count this item as painted.
+         *
+         * @details This doesn't paint anything. Sub-classes call this at the start of their paint() implementation so
+         *          that the views can report the number of items painted per frame.
+         */
+        void
+        paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+        /**
+         * Get the number of items painted since the counter was last reset.
+         *
+         * @note The counter is shared by all items.
+         *
+         * @return The number of painted items.
+         */
+        [[nodiscard]]
+        static
+        int
+        paintedCount();
+
+        /**
+         * Reset the painted items counter.
+         */
+        static
+        void
+        resetPaintedCount();
+
+        /**
+         * Get the cache mode this item should use with the current settings.
+         *
+         * @details This gets applied whenever the settings change. The default implementation keeps the current cache
+         *          mode. The built-in items return the corresponding `cacheMode*` setting.
+         *
+         * @return The cache mode.
+         */
+        [[nodiscard]]
+        virtual
+        QGraphicsItem::CacheMode
+        cacheModePolicy() const;
+
+        /**
+         * Whether toPixmap() may use the pixmap cache for this item.
+         *
+         * @details Caching is opt-in as the cache key only covers what pixmapCacheAttributes() writes. The default
+         *          implementation returns `false`. The built-in items return `true` for their own item type only, so
+         *          subclasses painting additional state must override this (and pixmapCacheAttributes()) to opt in.
+         *          An item is only cached if all of its children are cacheable too.
+         *
+         * @return Whether the rendered pixmap can be cached.
+         */
+        [[nodiscard]]
+        virtual
+        bool
+        pixmapCacheable() const;
+
+        /**
+         * Write the attributes affecting the rendering of this item to the pixmap cache key.
+         *
+         * @details The default implementation writes the type, the bounding rect and the selection, highlight &
+         *          visibility state. Items painting any other state (eg. a text) must override this and call the base
+         *          implementation. Don't write the position or the Z value as they don't affect the rendered pixmap.
+         *
+         * @param stream The stream.
+         */
+        virtual
+        void
+        pixmapCacheAttributes(QDataStream& stream) const;
+
         QVariant
         itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value) override;
 
@@ -267,6 +374,18 @@ namespace QSchematic::Items
         void rotChanged();
 
     private:
+        /**
+         * Compute the key used to look up the rendered item in the pixmap cache.
+         *
+         * @details The key is a salted hash of the rendered size & scale, the settings affecting painting and the
+         *          pixmapCacheAttributes() of the item and its children.
+         *
+         * @return The key. Empty if the item or one of its children isn't pixmapCacheable().
+         */
+        [[nodiscard]]
+        QByteArray
+        pixmapCacheKey(const QSizeF& size, qreal scale) const;
+
         int _type;
         bool _snapToGrid;
         bool _highlightEnabled;
@@ -7,6 +7,7 @@
 namespace QSchematic::Items
 {
     const QString MIME_TYPE_NODE = "qschematic/node";
+    const QString MIME_TYPE_ITEMS = "qschematic/items";     // Serialized items, wires & nets. See Scene::copySelection().
 
     class MimeData :
         public QMimeData
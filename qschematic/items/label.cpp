@@ -1,6 +1,8 @@
 #include "label.hpp"
 #include "../scene.hpp"
 
+#include <QCache>
+#include <QDataStream>
 #include <QFontMetricsF>
 #include <QPainter>
 #include <QPen>
@@ -8,9 +10,36 @@
 
 #include <boost/serialization/nvp.hpp>
 
+#include <cmath>
+
 const QColor COLOR_LABEL             = QColor("#000000");
 const QColor COLOR_LABEL_HIGHLIGHTED = QColor("#dc2479");
 const qreal LABEL_TEXT_PADDING = 2;
+const int TEXT_LAYOUT_CACHE_SIZE = 4096;
+
+namespace
+{
+    /**
+     * Text measurement & layout of labels showing the same text in the same font.
+     *
+     * @details Schematics tend to contain the same (connector) label text many times over. Instead of measuring the
+     *          text for each of them, the measured rectangle and the (implicitly shared) QStaticText are looked up
+     *          here. Labels are only used from the GUI thread.
+     */
+    struct TextLayout
+    {
+        QRectF textRect;
+        QStaticText staticText;
+    };
+
+    QCache<QString, TextLayout>&
+    textLayoutCache()
+    {
+        static QCache<QString, TextLayout> cache(TEXT_LAYOUT_CACHE_SIZE);
+
+        return cache;
+    }
+}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(QSchematic::Items::Label)
 
@@ -18,9 +47,17 @@ using namespace QSchematic::Items;
 
 Label::Label(int type, QGraphicsItem* parent) :
     Item(type, parent),
+    _fontMetrics(_font),
     _hasConnectionPoint(true)
 {
     setSnapToGrid(false);
+
+    // Text layout
+    QTextOption textOption;
+    textOption.setWrapMode(QTextOption::NoWrap);
+    _staticText.setTextFormat(Qt::PlainText);
+    _staticText.setTextOption(textOption);
+    _staticText.setPerformanceHint(QStaticText::AggressiveCaching);
 }
 
 template void Label::serialize<boost::archive::binary_oarchive>(boost::archive::binary_oarchive& ar, const unsigned int version);
@@ -75,6 +112,9 @@ void Label::copyAttributes(Label& dest) const
     // Attributes
     dest._text = _text;
     dest._font = _font;
+    dest._fontMetrics = _fontMetrics;
+    dest._staticText = _staticText;
+    dest._staticTextScale = _staticTextScale;
     dest._textRect = _textRect;
     dest._hasConnectionPoint = _hasConnectionPoint;
     dest._connectionPoint = _connectionPoint;
@@ -98,16 +138,21 @@ QPainterPath Label::shape() const
 
 void Label::setText(const QString& text)
 {
+    prepareGeometryChange();
     _text = text;
-    calculateTextRect();
+    updateTextLayout();
+    Item::update();
     Q_EMIT textChanged(_text);
 }
 
 void Label::setFont(const QFont& font)
 {
+    prepareGeometryChange();
     _font = font;
+    _fontMetrics = QFontMetricsF(_font);
 
-    calculateTextRect();
+    updateTextLayout();
+    Item::update();
 }
 
 void Label::setHasConnectionPoint(bool enabled)
@@ -127,11 +172,30 @@ void Label::setConnectionPoint(const QPointF& connectionPoint)
     Item::update();
 }
 
-void Label::calculateTextRect()
+QPointF Label::connectionPoint() const
+{
+    return _connectionPoint;
+}
+
+void Label::updateTextLayout()
 {
-    QFontMetricsF fontMetrics(_font);
-    _textRect = fontMetrics.boundingRect(_text);
+    // Needs to be prepared again
+    _staticTextScale = 0;
+
+    // Use the shared layout if there is one
+    auto& cache = textLayoutCache();
+    const QString key = _font.key() + QChar::Null + _text;
+    if (const TextLayout* layout = cache.object(key)) {
+        _textRect = layout->textRect;
+        _staticText = layout->staticText;
+        return;
+    }
+
+    _textRect = _fontMetrics.boundingRect(_text);
     _textRect.adjust(-LABEL_TEXT_PADDING, -LABEL_TEXT_PADDING, LABEL_TEXT_PADDING, LABEL_TEXT_PADDING);
+    _staticText.setText(_text);
+
+    cache.insert(key, new TextLayout{ _textRect, _staticText });
 }
 
 QString Label::text() const
@@ -151,8 +215,7 @@ QRectF Label::textRect() const
 
 void Label::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    Item::paint(painter, option, widget);
 
     // Draw a dashed line to the wire if selected
     if (isHighlighted()) {
@@ -183,24 +246,29 @@ void Label::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
         painter->drawRect(_textRect);
     }
 
-    // Text pen
-    QPen textPen;
-    textPen.setStyle(Qt::SolidLine);
-    textPen.setColor(Qt::black);
+    // Draw the text (unless it would be too small to be legible)
+    if (const qreal lod = levelOfDetail(*painter, option); lod >= _settings->lodMinScaleText) {
+        // Lay out the text again if the scale changed. The scale is rounded up to the next power of two so that
+        // zooming only lays out the text again once the scale doubled or halved.
+        const qreal scale = std::exp2(std::ceil(std::log2(lod)));
+        if (!qFuzzyCompare(scale, _staticTextScale)) {
+            _staticText.prepare(QTransform::fromScale(scale, scale), _font);
+            _staticTextScale = scale;
+        }
 
-    // Text option
-    QTextOption textOption;
-    textOption.setWrapMode(QTextOption::NoWrap);
-    textOption.setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
+        // Center the text in the text rectangle
+        const QSizeF& textSize = _staticText.size();
+        const QPointF textPos(_textRect.center().x() - textSize.width() / 2, _textRect.center().y() - textSize.height() / 2);
 
-    // Draw the text
-    painter->setPen(COLOR_LABEL);
-    painter->setBrush(Qt::NoBrush);
-    painter->setFont(_font);
-    painter->drawText(_textRect, _text, textOption);
+        // Draw the text
+        painter->setPen(COLOR_LABEL);
+        painter->setBrush(Qt::NoBrush);
+        painter->setFont(_font);
+        painter->drawStaticText(textPos, _staticText);
+    }
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::red);
         painter->setBrush(Qt::NoBrush);
         painter->drawRect(boundingRect());
@@ -209,6 +277,24 @@ void Label::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWi
     }
 }
 
+QGraphicsItem::CacheMode Label::cacheModePolicy() const
+{
+    return static_cast<QGraphicsItem::CacheMode>(_settings->cacheModeLabel);
+}
+
+bool Label::pixmapCacheable() const
+{
+    // Subclasses may paint more than the attributes cover
+    return type() == Item::LabelType;
+}
+
+void Label::pixmapCacheAttributes(QDataStream& stream) const
+{
+    Item::pixmapCacheAttributes(stream);
+
+    stream << _text << _font.key() << _textRect << _hasConnectionPoint << _connectionPoint;
+}
+
 void Label::mouseDoubleClickEvent([[maybe_unused]] QGraphicsSceneMouseEvent* event)
 {
     Q_EMIT doubleClicked();
@@ -3,6 +3,8 @@
 #include "item.hpp"
 
 #include <QFont>
+#include <QFontMetricsF>
+#include <QStaticText>
 
 #include <boost/serialization/export.hpp>
 
@@ -43,18 +45,25 @@ namespace QSchematic::Items
         void setHasConnectionPoint(bool enabled);
         bool hasConnectionPoint() const;
         void setConnectionPoint(const QPointF& connectionPoint);    // Parent coordinates
+        QPointF connectionPoint() const;                            // Parent coordinates
         QRectF textRect() const;
 
     protected:
         void copyAttributes(Label& dest) const;
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
         void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event) override;
+        QGraphicsItem::CacheMode cacheModePolicy() const override;
+        bool pixmapCacheable() const override;
+        void pixmapCacheAttributes(QDataStream& stream) const override;
 
     private:
-        void calculateTextRect();
+        void updateTextLayout();
 
         QString _text;
         QFont _font;
+        QFontMetricsF _fontMetrics;
+        QStaticText _staticText;        // Layout of the text, prepared for _staticTextScale. Shared with identical labels until prepared.
+        qreal _staticTextScale = 0;     // Power of two, 0 if not prepared yet
         QRectF _textRect;
         bool _hasConnectionPoint;
         QPointF _connectionPoint;   // Parent coordinates
@@ -1,13 +1,16 @@
 #include "node.hpp"
+#include "symbol.hpp"
 #include "../utils.hpp"
 #include "../scene.hpp"
 
 #include <QApplication>
+#include <QDataStream>
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
 #include <QtMath>
 
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 
 const QColor COLOR_HIGHLIGHTED = QColor(Qt::blue);
@@ -45,7 +48,6 @@ template void Node::serialize<boost::archive::xml_iarchive>(boost::archive::xml_
 template<class Archive>
 void Node::save(Archive& ar, const unsigned int version) const
 {
-    Q_UNUSED(version)
 
     // Connectors configuration
     ar& boost::serialization::make_nvp("connectors_movable", _connectorsMovable);
@@ -76,12 +78,17 @@ void Node::save(Archive& ar, const unsigned int version) const
     ar& boost::serialization::make_nvp("allow_mouse_resize", amr);
     bool amrot = allowMouseRotate();
     ar& boost::serialization::make_nvp("allow_mouse_rotate", amrot);
+
+    // Symbol
+    if (version >= 1) {
+        std::string symbolName = _symbol ? _symbol->name.toStdString() : std::string();
+        ar & boost::serialization::make_nvp("symbol", symbolName);
+    }
 }
 
 template<class Archive>
 void Node::load(Archive& ar, const unsigned int version)
 {
-    Q_UNUSED(version)
 
     // Connectors configuration
     bool connectorsMovable;
@@ -113,6 +120,16 @@ void Node::load(Archive& ar, const unsigned int version)
     setAllowMouseResize(allowMouseResize);
     ar & boost::serialization::make_nvp("allow_mouse_rotate", allowMouseRotate);
     setAllowMouseRotate(allowMouseRotate);
+
+    // Symbol
+    // The connectors were restored above already (they carry the per-instance state), so only reference the shared
+    // definition again.
+    _symbol.reset();
+    if (version >= 1) {
+        std::string symbolName;
+        ar & boost::serialization::make_nvp("symbol", symbolName);
+        linkSymbol(QString::fromStdString(symbolName));
+    }
 }
 
 std::shared_ptr<Item> Node::deepCopy() const
@@ -145,6 +162,7 @@ void Node::copyAttributes(Node& dest) const
     dest._connectorsSnapPolicy = _connectorsSnapPolicy;
     dest._connectorsSnapToGrid = _connectorsSnapToGrid;
     dest._specialConnectors = _specialConnectors;
+    dest._symbol = _symbol;
 }
 
 void Node::addSpecialConnector(const std::shared_ptr<Connector>& connector)
@@ -295,6 +313,11 @@ bool Node::connectorsSnapToGrid() const
     return _connectorsSnapToGrid;
 }
 
+bool Node::isSpecialConnector(const std::shared_ptr<Connector>& connector) const
+{
+    return _specialConnectors.contains(connector);
+}
+
 void Node::alignConnectorLabels() const
 {
     for (auto connector : _connectors) {
@@ -303,6 +326,84 @@ void Node::alignConnectorLabels() const
     }
 }
 
+/**
+ * Makes this node an instance of the specified symbol.
+ *
+ * @details The connectors, the size and the connector & mouse interaction policies are (re-)created from the
+ *          definition. The definition itself is shared, not copied. Special connectors are left untouched.
+ *          Passing nullptr turns this node into a standalone node but keeps its current connectors.
+ *
+ * @note The node still gets its own connector items, so this doesn't make the node any smaller. It only shares the
+ *       body path and the symbol description.
+ *
+ * @param symbol The symbol definition.
+ */
+void Node::setSymbol(const std::shared_ptr<const SymbolDefinition>& symbol)
+{
+    _symbol = symbol;
+    if (!_symbol) {
+        return;
+    }
+
+    // Policies
+    setConnectorsMovable(_symbol->connectorsMovable);
+    setConnectorsSnapPolicy(_symbol->connectorsSnapPolicy);
+    setConnectorsSnapToGrid(_symbol->connectorsSnapToGrid);
+    setAllowMouseResize(_symbol->allowMouseResize);
+    setAllowMouseRotate(_symbol->allowMouseRotate);
+
+    // Size
+    setSize(_symbol->size);
+
+    // Connectors
+    auto s = scene();
+    for (const auto& connector : connectors()) {
+        if (_specialConnectors.contains(connector)) {
+            continue;
+        }
+
+        if (s) {
+            s->removeItem(connector);
+        }
+        removeConnector(connector);
+    }
+    _connectors.reserve(_symbol->connectors.size() + _specialConnectors.size());
+    for (const auto& definition : _symbol->connectors) {
+        addConnector(std::make_shared<Connector>(Item::ConnectorType, definition.gridPos, definition.text));
+    }
+}
+
+std::shared_ptr<const SymbolDefinition> Node::symbol() const
+{
+    return _symbol;
+}
+
+/**
+ * References the symbol definition registered under the specified name in the SymbolLibrary.
+ *
+ * @details Unlike setSymbol() this leaves the connectors, the size and the policies untouched. This is used when
+ *          loading a node whose per-instance state was restored already. Unknown names turn this node into a
+ *          standalone node.
+ *
+ * @param name The symbol name.
+ * @return Whether the symbol was found.
+ */
+bool Node::linkSymbol(const QString& name)
+{
+    _symbol.reset();
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    _symbol = SymbolLibrary::instance().find(name);
+    if (!_symbol) {
+        qCritical("Node::linkSymbol(): Unknown symbol. Keeping node as a standalone node.");
+        return false;
+    }
+
+    return true;
+}
+
 void Node::sizeChangedEvent(const QSizeF oldSize, const QSizeF newSize)
 {
     for (const auto& connector : connectors()) {
@@ -316,11 +417,14 @@ void Node::sizeChangedEvent(const QSizeF oldSize, const QSizeF newSize)
 
 void Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    Item::paint(painter, option, widget);
+
+    // Level of detail
+    const bool drawDetails = levelOfDetail(*painter, option) >= _settings->lodMinScaleDetails;
+    const qreal cornerRadius = drawDetails ? _settings->gridSize/2 : 0;
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
@@ -341,8 +445,8 @@ void Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
         painter->setPen(highlightPen);
         painter->setBrush(highlightBrush);
         painter->setOpacity(0.5);
-        int adj = _settings.highlightRectPadding;
-        painter->drawRoundedRect(sizeRect().adjusted(-adj, -adj, adj, adj), _settings.gridSize/2, _settings.gridSize/2);
+        int adj = _settings->highlightRectPadding;
+        painter->drawRoundedRect(sizeRect().adjusted(-adj, -adj, adj, adj), cornerRadius, cornerRadius);
     }
 
     painter->setOpacity(1.0);
@@ -361,15 +465,27 @@ void Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
     // Draw the component body
     painter->setPen(bodyPen);
     painter->setBrush(bodyBrush);
-    painter->drawRoundedRect(sizeRect(), _settings.gridSize/2, _settings.gridSize/2);
+    if (_symbol && !_symbol->body.isEmpty()) {
+        // The body geometry is shared between all instances, only scale it if this instance got resized
+        if (size() == _symbol->size || _symbol->size.isEmpty()) {
+            painter->drawPath(_symbol->body);
+        } else {
+            painter->save();
+            painter->scale(size().width() / _symbol->size.width(), size().height() / _symbol->size.height());
+            painter->drawPath(_symbol->body);
+            painter->restore();
+        }
+    } else {
+        painter->drawRoundedRect(sizeRect(), cornerRadius, cornerRadius);
+    }
 
     // Resize handles
-    if (isSelected() && allowMouseResize()) {
+    if (drawDetails && isSelected() && allowMouseResize()) {
         paintResizeHandles(*painter);
     }
 
     // Rotate handle
-    if (isSelected() && allowMouseRotate()) {
+    if (drawDetails && isSelected() && allowMouseRotate()) {
         paintRotateHandle(*painter);
     }
 }
@@ -382,6 +498,24 @@ void Node::update()
     QGraphicsObject::update();
 }
 
+QGraphicsItem::CacheMode Node::cacheModePolicy() const
+{
+    return static_cast<QGraphicsItem::CacheMode>(_settings->cacheModeNode);
+}
+
+bool Node::pixmapCacheable() const
+{
+    // Subclasses may paint more than the attributes cover
+    return type() == Item::NodeType;
+}
+
+void Node::pixmapCacheAttributes(QDataStream& stream) const
+{
+    RectItem::pixmapCacheAttributes(stream);
+
+    stream << (_symbol ? _symbol->name : QString());
+}
+
 void Node::propagateSettings()
 {
     for (const auto& connector : connectors()) {
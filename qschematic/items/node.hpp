@@ -4,8 +4,12 @@
 #include "connector.hpp"
 #include "../types.hpp"
 
+#include <boost/serialization/version.hpp>
+
 #include <QList>
 
+#include <memory>
+
 class QGraphicsSceneMouseEvent;
 class QGraphicsSceneHoverEvent;
 
@@ -13,6 +17,7 @@ namespace QSchematic::Items
 {
 
     class Connector;
+    struct SymbolDefinition;
 
     class Node :
         public RectItem
@@ -44,7 +49,11 @@ namespace QSchematic::Items
         Connector::SnapPolicy connectorsSnapPolicy() const;
         void setConnectorsSnapToGrid(bool enabled);
         bool connectorsSnapToGrid() const;
+        bool isSpecialConnector(const std::shared_ptr<Connector>& connector) const;
         void alignConnectorLabels() const;
+        void setSymbol(const std::shared_ptr<const SymbolDefinition>& symbol);
+        std::shared_ptr<const SymbolDefinition> symbol() const;
+        bool linkSymbol(const QString& name);
 
         void sizeChangedEvent(QSizeF oldSize, QSizeF newSize) override;
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
@@ -52,6 +61,9 @@ namespace QSchematic::Items
 
     protected:
         void copyAttributes(Node& dest) const;
+        QGraphicsItem::CacheMode cacheModePolicy() const override;
+        bool pixmapCacheable() const override;
+        void pixmapCacheAttributes(QDataStream& stream) const override;
         void addSpecialConnector(const std::shared_ptr<Connector>& connectors);
 
     private:
@@ -62,8 +74,10 @@ namespace QSchematic::Items
         bool _connectorsSnapToGrid;
         QList<std::shared_ptr<Connector>> _connectors;
         QList<std::shared_ptr<Connector>> _specialConnectors;  // Ignored in serialization and deep-copy
+        std::shared_ptr<const SymbolDefinition> _symbol;       // Shared between all instances of the same symbol
     };
 
 }
 
 BOOST_CLASS_EXPORT_KEY(QSchematic::Items::Node)
+BOOST_CLASS_VERSION(QSchematic::Items::Node, 1)
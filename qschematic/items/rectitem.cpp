@@ -5,6 +5,7 @@
 #include "../commands/rectitem_rotate.hpp"
 
 #include <QApplication>
+#include <QDataStream>
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
 #include <QtMath>
@@ -136,6 +137,11 @@ void RectItem::setMinimumSize(const QSizeF& size)
     _minimumSize = size;
 }
 
+QSizeF RectItem::minimumSize() const
+{
+    return _minimumSize;
+}
+
 void RectItem::setSize(QSizeF size)
 {
     // Honor minimum size
@@ -160,6 +166,10 @@ void RectItem::setSize(QSizeF size)
 
     sizeChangedEvent(oldSize, _size);
     Q_EMIT sizeChanged();
+    Q_EMIT geometryChanged(*this);
+
+    // Invalidate the cache
+    update();
 }
 
 void RectItem::setSize(qreal width, qreal height)
@@ -225,7 +235,7 @@ bool RectItem::allowMouseRotate() const
 QMap<RectanglePoint, QRectF> RectItem::resizeHandles() const
 {
     QMap<RectanglePoint, QRectF> map;
-    const int& resizeHandleSize = _settings.resizeHandleSize;
+    const int& resizeHandleSize = _settings->resizeHandleSize;
 
     const QRectF& r = sizeRect();
 
@@ -251,7 +261,7 @@ QMap<RectanglePoint, QRectF> RectItem::resizeHandles() const
 QRectF RectItem::rotationHandle() const
 {
     const QRectF& r = sizeRect();
-    const int& resizeHandleSize = _settings.resizeHandleSize;
+    const int& resizeHandleSize = _settings->resizeHandleSize;
     return QRectF(Utils::centerPoint(r.topRight(), r.topLeft())+QPointF(1,-resizeHandleSize*3)-QPointF(resizeHandleSize, resizeHandleSize), QSizeF(2*resizeHandleSize, 2*resizeHandleSize));
 }
 
@@ -330,7 +340,7 @@ void RectItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
         if (event->buttons() & Qt::LeftButton) {
 
             if ( canSnapToGrid() ) {
-                newMousePos = _settings.snapToGrid( newMousePos );
+                newMousePos = _settings->snapToGrid( newMousePos );
             }
 
             // Calculate mouse movement in grid units
@@ -408,7 +418,7 @@ void RectItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
             QPointF newPos( newX, newY );
             QSizeF newSize( newWidth, newHeight );
             if ( canSnapToGrid() ) {
-                newSize = _settings.snapToGrid( newSize );
+                newSize = _settings->snapToGrid( newSize );
             }
 
             // Minimum size
@@ -531,12 +541,12 @@ QRectF RectItem::boundingRect() const
 
     // Add resize handles
     if (isSelected() && _allowMouseResize) {
-        adj = qMax(adj, static_cast<qreal>(_settings.resizeHandleSize));
+        adj = qMax(adj, static_cast<qreal>(_settings->resizeHandleSize));
     }
 
     // Add highlight rect
     if (isHighlighted()) {
-        adj = qMax(adj, static_cast<qreal>(_settings.highlightRectPadding));
+        adj = qMax(adj, static_cast<qreal>(_settings->highlightRectPadding));
     }
 
     // adjustment should be done before union with other rects, otherwise the
@@ -553,11 +563,14 @@ QRectF RectItem::boundingRect() const
 
 void RectItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    Item::paint(painter, option, widget);
+
+    // Level of detail
+    const bool drawDetails = levelOfDetail(*painter, option) >= _settings->lodMinScaleDetails;
+    const qreal cornerRadius = drawDetails ? _settings->gridSize/2 : 0;
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
@@ -578,8 +591,8 @@ void RectItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
         painter->setPen(highlightPen);
         painter->setBrush(highlightBrush);
         painter->setOpacity(0.5);
-        int adj = _settings.highlightRectPadding;
-        painter->drawRoundedRect(sizeRect().adjusted(-adj, -adj, adj, adj), _settings.gridSize/2, _settings.gridSize/2);
+        int adj = _settings->highlightRectPadding;
+        painter->drawRoundedRect(sizeRect().adjusted(-adj, -adj, adj, adj), cornerRadius, cornerRadius);
     }
 
     painter->setOpacity(1.0);
@@ -598,15 +611,15 @@ void RectItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     // Draw the component body
     painter->setPen(bodyPen);
     painter->setBrush(bodyBrush);
-    painter->drawRoundedRect(sizeRect(), _settings.gridSize/2, _settings.gridSize/2);
+    painter->drawRoundedRect(sizeRect(), cornerRadius, cornerRadius);
 
     // Resize handles
-    if (isSelected() && allowMouseResize()) {
+    if (drawDetails && isSelected() && allowMouseResize()) {
         paintResizeHandles(*painter);
     }
 
     // Rotate handle
-    if (isSelected() && allowMouseRotate()) {
+    if (drawDetails && isSelected() && allowMouseRotate()) {
         paintRotateHandle(*painter);
     }
 }
@@ -637,13 +650,13 @@ QVariant RectItem::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
             // the height and width is odd then the position needs to be
             // offset by half a grid unit vertically and horizontally.
             if ((qFuzzyCompare(qAbs(rotation()), 90) || qFuzzyCompare(qAbs(rotation()), 270)) &&
-                (fmod(_size.width()/_settings.gridSize - _size.height()/_settings.gridSize, 2) != 0))
+                (fmod(_size.width()/_settings->gridSize - _size.height()/_settings->gridSize, 2) != 0))
             {
-                newPos.setX(qCeil(newPos.rx()/_settings.gridSize)*_settings.gridSize);
-                newPos.setY(qCeil(newPos.ry()/_settings.gridSize)*_settings.gridSize);
-                newPos -= QPointF(_settings.gridSize/2, _settings.gridSize/2);
+                newPos.setX(qCeil(newPos.rx()/_settings->gridSize)*_settings->gridSize);
+                newPos.setY(qCeil(newPos.ry()/_settings->gridSize)*_settings->gridSize);
+                newPos -= QPointF(_settings->gridSize/2, _settings->gridSize/2);
             } else {
-                newPos = _settings.snapToGrid(newPos);
+                newPos = _settings->snapToGrid(newPos);
             }
         }
         return newPos;
@@ -673,7 +686,7 @@ void RectItem::paintResizeHandles(QPainter& painter)
         painter.drawRect(rect.adjusted(-handlePen.width(), -handlePen.width(), handlePen.width()/2, handlePen.width()/2));
 
         // Draw the inner handle
-        int adj = _settings.resizeHandleSize/2;
+        int adj = _settings->resizeHandleSize/2;
         handleBrush.setColor(Qt::white);
         painter.setBrush(handleBrush);
         painter.drawRect(rect.adjusted(-handlePen.width()+adj, -handlePen.width()+adj, (handlePen.width()/2)-adj, (handlePen.width()/2)-adj));
@@ -700,8 +713,15 @@ void RectItem::paintRotateHandle(QPainter& painter)
     painter.drawEllipse(rect.adjusted(-handlePen.width(), -handlePen.width(), handlePen.width()/2, handlePen.width()/2));
 
     // Draw the inner handle
-    int adj = _settings.resizeHandleSize/2;
+    int adj = _settings->resizeHandleSize/2;
     handleBrush.setColor(Qt::white);
     painter.setBrush(handleBrush);
     painter.drawEllipse(rect.adjusted(-handlePen.width()+adj, -handlePen.width()+adj, (handlePen.width()/2)-adj, (handlePen.width()/2)-adj));
 }
+
+void RectItem::pixmapCacheAttributes(QDataStream& stream) const
+{
+    Item::pixmapCacheAttributes(stream);
+
+    stream << _size << _allowMouseResize << _allowMouseRotate;
+}
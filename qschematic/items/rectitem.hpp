@@ -45,6 +45,7 @@ namespace QSchematic::Items
 
         Mode mode() const;
         void setMinimumSize(const QSizeF& size);
+        QSizeF minimumSize() const;
         void setSize(QSizeF size);
         void setSize(qreal width, qreal height);
         void setWidth(qreal width);
@@ -84,6 +85,7 @@ namespace QSchematic::Items
         QRectF rotationHandle() const;
         virtual void paintResizeHandles(QPainter& painter);
         virtual void paintRotateHandle(QPainter& painter);
+        void pixmapCacheAttributes(QDataStream& stream) const override;
 
     private:
         Mode _mode;
@@ -19,10 +19,14 @@ SplineWire::SplineWire(int type, QGraphicsItem* parent) :
 
 }
 
+bool SplineWire::batchable() const
+{
+    return false;
+}
+
 void SplineWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
+    Item::paint(painter, option, widget);
 
     // Pen
     QPen penLine;
@@ -88,7 +92,7 @@ void SplineWire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
     }
 
     // Draw debugging stuff
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::red);
         painter->setBrush(Qt::NoBrush);
         painter->drawRect(boundingRect());
@@ -15,6 +15,7 @@ namespace QSchematic::Items
         ~SplineWire() override = default;
 
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+        bool batchable() const override;
         QPainterPath path() const;
         QPainterPath shape() const override;
         QRectF boundingRect() const override;
@@ -0,0 +1,67 @@
+#include "symbol.hpp"
+#include "node.hpp"
+
+using namespace QSchematic::Items;
+
+std::shared_ptr<const SymbolDefinition>
+SymbolDefinition::fromNode(const Node& node, const QString& name)
+{
+    auto symbol = std::make_shared<SymbolDefinition>();
+    symbol->name = name;
+    symbol->size = node.size();
+    symbol->connectorsMovable = node.connectorsMovable();
+    symbol->connectorsSnapPolicy = node.connectorsSnapPolicy();
+    symbol->connectorsSnapToGrid = node.connectorsSnapToGrid();
+    symbol->allowMouseResize = node.allowMouseResize();
+    symbol->allowMouseRotate = node.allowMouseRotate();
+
+    const auto& connectors = node.connectors();
+    symbol->connectors.reserve(connectors.size());
+    for (const auto& connector : connectors) {
+        if (node.isSpecialConnector(connector)) {
+            continue;
+        }
+
+        symbol->connectors.push_back({ connector->gridPos(), connector->text() });
+    }
+
+    return symbol;
+}
+
+SymbolLibrary&
+SymbolLibrary::instance()
+{
+    static SymbolLibrary library;
+
+    return library;
+}
+
+bool
+SymbolLibrary::add(const std::shared_ptr<const SymbolDefinition>& symbol)
+{
+    if (!symbol || symbol->name.isEmpty()) {
+        return false;
+    }
+
+    m_symbols.insert(symbol->name, symbol);
+
+    return true;
+}
+
+void
+SymbolLibrary::remove(const QString& name)
+{
+    m_symbols.remove(name);
+}
+
+void
+SymbolLibrary::clear()
+{
+    m_symbols.clear();
+}
+
+std::shared_ptr<const SymbolDefinition>
+SymbolLibrary::find(const QString& name) const
+{
+    return m_symbols.value(name);
+}
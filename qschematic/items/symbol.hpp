@@ -0,0 +1,117 @@
+#pragma once
+
+#include "connector.hpp"
+
+#include <QHash>
+#include <QPainterPath>
+#include <QPoint>
+#include <QSizeF>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+namespace QSchematic::Items
+{
+
+    class Node;
+
+    /**
+     * Shared, immutable description of a node type.
+     *
+     * @details Most nodes in a schematic are instances of a small number of symbol types. Instead of every node
+     *          carrying its own copy of the body geometry, instances reference the same definition.
+     *          Definitions are never modified once they are shared. Use SymbolLibrary to make them resolvable by name
+     *          when loading.
+     *
+     * @note This doesn't reduce the memory per instance. Each instance still owns its node state and one connector
+     *       item per entry of `connectors` (they are what wires attach to), so an instance is as large as a standalone
+     *       node with the same connectors. Only the body path and the definition itself are stored once.
+     */
+    struct SymbolDefinition
+    {
+        struct ConnectorDefinition
+        {
+            QPoint gridPos;
+            QString text;
+        };
+
+        QString name;
+        QSizeF size;
+        QPainterPath body;                                                              // Empty to draw the default node body
+        QVector<ConnectorDefinition> connectors;
+        bool connectorsMovable = false;
+        Connector::SnapPolicy connectorsSnapPolicy = Connector::NodeSizerectOutline;
+        bool connectorsSnapToGrid = true;
+        bool allowMouseResize = true;
+        bool allowMouseRotate = true;
+
+        /**
+         * Creates a definition from the current state of a node.
+         *
+         * @note Special connectors are not part of the definition.
+         *
+         * @param node The node to describe.
+         * @param name The symbol name.
+         * @return The new definition.
+         */
+        [[nodiscard]]
+        static
+        std::shared_ptr<const SymbolDefinition>
+        fromNode(const Node& node, const QString& name);
+    };
+
+    /**
+     * Process-wide registry of symbol definitions.
+     *
+     * @details Nodes only store the name of their symbol when serialized. When loading, the name is resolved through
+     *          this registry so instances share the definition again.
+     *
+     * @note This must only be used from the GUI thread.
+     */
+    class SymbolLibrary
+    {
+    public:
+        /**
+         * Get the process-wide instance.
+         */
+        [[nodiscard]]
+        static
+        SymbolLibrary&
+        instance();
+
+        /**
+         * Registers a symbol definition.
+         *
+         * @note An existing definition with the same name is replaced. Nodes which already reference the previous
+         *       definition keep it.
+         *
+         * @param symbol The definition.
+         * @return Whether the definition was registered.
+         */
+        bool
+        add(const std::shared_ptr<const SymbolDefinition>& symbol);
+
+        void
+        remove(const QString& name);
+
+        void
+        clear();
+
+        /**
+         * Looks up a symbol definition.
+         *
+         * @param name The symbol name.
+         * @return The definition or nullptr if no definition with that name is registered.
+         */
+        [[nodiscard]]
+        std::shared_ptr<const SymbolDefinition>
+        find(const QString& name) const;
+
+    private:
+        SymbolLibrary() = default;
+
+        QHash<QString, std::shared_ptr<const SymbolDefinition>> m_symbols;
+    };
+
+}
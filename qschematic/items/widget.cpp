@@ -67,13 +67,12 @@ Widget::sizeChangedEvent(QSizeF oldSize, QSizeF newSize)
 void
 Widget::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option)
-    Q_UNUSED(widget)
+    Item::paint(painter, option, widget);
 
     painter->save();
 
     // Draw the bounding rect if debug mode is enabled
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::NoPen);
         painter->setBrush(QBrush(Qt::red));
         painter->drawRect(boundingRect());
@@ -8,6 +8,7 @@
 
 #include <QPen>
 #include <QBrush>
+#include <QDataStream>
 #include <QPainter>
 #include <QMap>
 #include <QGraphicsSceneHoverEvent>
@@ -19,6 +20,8 @@
 
 #include <boost/serialization/vector.hpp>
 
+#include <algorithm>
+
 const qreal BOUNDING_RECT_PADDING = 6.0;
 const qreal HANDLE_SIZE = 3.0;
 const qreal WIRE_SHAPE_PADDING = 10;
@@ -48,7 +51,7 @@ Wire::~Wire()
 {
     if (auto wire_net = std::dynamic_pointer_cast<WireNet>(net())) {
         // Make sure that we don't delete the net's label
-        if (childItems().contains(wire_net->label().get())) {
+        if (wire_net->hasLabel() && childItems().contains(wire_net->label().get())) {
             wire_net->label()->setParentItem(nullptr);
         }
     }
@@ -91,9 +94,12 @@ void Wire::load(Archive& ar, const unsigned int version)
     std::vector<int> points_y;
     ar & boost::serialization::make_nvp("points_x", points_x);
     ar & boost::serialization::make_nvp("points_y", points_y);
+    m_points.reserve(points_x.size());
     for (int i = 0; i < points_x.size(); ++i) {
         m_points.append(point(points_x.at(i), points_y.at(i)));
     }
+    mark_modified(0, points_count() - 1);
+    invalidateGeometry();
 
     // Update
     update();
@@ -112,6 +118,7 @@ void Wire::copyAttributes(Wire& dest) const
     Item::copyAttributes(dest);
 
     dest.m_points = m_points;
+    dest.invalidateGeometry();
     dest._rect = _rect;
     dest._pointToMoveIndex = _pointToMoveIndex;
     dest._lineSegmentToMoveIndex = _lineSegmentToMoveIndex;
@@ -132,46 +139,39 @@ QRectF Wire::boundingRect() const
 
 QPainterPath Wire::shape() const
 {
-    QPainterPath basePath;
-    basePath.addPolygon(QPolygonF(pointsRelative()));
+    const Geometry& geo = geometry();
+
+    // Stroke the shape only when needed. This is used for every hit test.
+    if (!geo.shapeValid) {
+        QPainterPath basePath;
+        basePath.addPolygon(QPolygonF(geo.pointsRelative));
 
-    QPainterPathStroker str;
-    str.setCapStyle(Qt::FlatCap);
-    str.setJoinStyle(Qt::MiterJoin);
-    str.setWidth(WIRE_SHAPE_PADDING);
+        QPainterPathStroker str;
+        str.setCapStyle(Qt::FlatCap);
+        str.setJoinStyle(Qt::MiterJoin);
+        str.setWidth(WIRE_SHAPE_PADDING);
 
-    QPainterPath resultPath = str.createStroke(basePath).simplified();
+        _geometry.shape = str.createStroke(basePath).simplified();
+        _geometry.shapeValid = true;
+    }
 
-    return resultPath;
+    return geo.shape;
 }
 
 QVector<point> Wire::wirePointsRelative() const
 {
-    QVector<point> relativePoints(m_points);
-
-    for (point& point : relativePoints) {
-        bool isJunction = point.is_junction();
-        point = point.toPointF() - pos();
-        point.set_is_junction(isJunction);
-    }
-
-    return relativePoints;
+    return geometry().wirePointsRelative;
 }
 
 QVector<QPointF> Wire::pointsRelative() const
 {
-    QVector<QPointF> points;
-
-    for (const point& point : m_points) {
-        points << point.toPointF() - pos();
-    }
-
-    return points;
+    return geometry().pointsRelative;
 }
 
 QVector<QPointF> Wire::pointsAbsolute() const
 {
     QVector<QPointF> points;
+    points.reserve(m_points.size());
 
     for (const point& point : m_points) {
         points << point.toPointF();
@@ -182,28 +182,65 @@ QVector<QPointF> Wire::pointsAbsolute() const
 
 void Wire::calculateBoundingRect()
 {
-    // Find top-left most point
-    const int& intMaxValue = std::numeric_limits<int>::max();
-    QPointF topLeft(intMaxValue, intMaxValue);
-    for (auto& point : wirePointsRelative()) {
-        if (point.x() < topLeft.x())
-            topLeft.setX(point.x());
-        if (point.y() < topLeft.y())
-            topLeft.setY(point.y());
+    const QRectF& rect = geometry().rect;
+    if (rect == _rect)
+        return;
+
+    _rect = rect;
+
+    Q_EMIT geometryChanged(*this);
+}
+
+void Wire::invalidateGeometry()
+{
+    _geometryVersion++;
+}
+
+const Wire::Geometry& Wire::geometry() const
+{
+    const QPointF& currentPos = pos();
+    if (_geometry.version == _geometryVersion && _geometry.pos == currentPos)
+        return _geometry;
+
+    _geometry.version = _geometryVersion;
+    _geometry.pos = currentPos;
+    _geometry.shape = QPainterPath();
+    _geometry.shapeValid = false;
+    _geometry.pointsRelative.clear();
+    _geometry.pointsRelative.reserve(m_points.size());
+    _geometry.wirePointsRelative.clear();
+    _geometry.wirePointsRelative.reserve(m_points.size());
+    _geometry.junctions.clear();
+
+    // Relative points
+    for (int i = 0; i < m_points.size(); ++i) {
+        const point& wirePoint = m_points.at(i);
+
+        point relativePoint = wirePoint.toPointF() - currentPos;
+        relativePoint.set_is_junction(wirePoint.is_junction());
+        _geometry.pointsRelative << relativePoint.toPointF();
+        _geometry.wirePointsRelative << relativePoint;
+
+        if (wirePoint.is_junction())
+            _geometry.junctions << i;
     }
 
-    // Find bottom-right most point
-    const int& intMinValue = std::numeric_limits<int>::min();
-    QPointF bottomRight(intMinValue, intMinValue);
-    for (auto& point : wirePointsRelative()) {
-        if (point.x() > bottomRight.x())
-            bottomRight.setX(point.x());
-        if (point.y() > bottomRight.y())
-            bottomRight.setY(point.y());
+    // Bounds
+    if (_geometry.pointsRelative.isEmpty())
+        _geometry.rect = QRectF();
+    else {
+        QPointF topLeft = _geometry.pointsRelative.first();
+        QPointF bottomRight = topLeft;
+        for (const QPointF& point : _geometry.pointsRelative) {
+            topLeft.setX(std::min(topLeft.x(), point.x()));
+            topLeft.setY(std::min(topLeft.y(), point.y()));
+            bottomRight.setX(std::max(bottomRight.x(), point.x()));
+            bottomRight.setY(std::max(bottomRight.y(), point.y()));
+        }
+        _geometry.rect = QRectF(topLeft, bottomRight);
     }
 
-    // Create the rectangle
-    _rect = QRectF(topLeft, bottomRight);
+    return _geometry;
 }
 
 void Wire::setRenameAction(QAction* action)
@@ -213,6 +250,10 @@ void Wire::setRenameAction(QAction* action)
 
 void Wire::prepend_point(const QPointF& point)
 {
+    // Keep track of the point being dragged
+    if (_pointToMoveIndex >= 0) {
+        _pointToMoveIndex++;
+    }
     wire::prepend_point(point);
     Q_EMIT pointMoved(*this, wirePointsRelative().first());
 }
@@ -225,6 +266,10 @@ void Wire::append_point(const QPointF& point)
 
 void Wire::insert_point(int index, const QPointF& point)
 {
+    // Keep track of the point being dragged
+    if (_pointToMoveIndex >= 0 && index >= 0 && index <= _pointToMoveIndex && index < points_count()) {
+        _pointToMoveIndex++;
+    }
     wire::insert_point(index, point);
     Q_EMIT pointMoved(*this, wirePointsRelative()[index]);
 }
@@ -236,6 +281,12 @@ void Wire::removeFirstPoint()
     }
     prepareGeometryChange();
     m_points.removeFirst();
+    shift_modified(0, -1);
+    mark_modified(0, 0);
+    if (_pointToMoveIndex > 0) {
+        _pointToMoveIndex--;
+    }
+    invalidateGeometry();
     calculateBoundingRect();
 }
 
@@ -247,6 +298,8 @@ void Wire::removeLastPoint()
 
     prepareGeometryChange();
     m_points.removeLast();
+    mark_modified(points_count() - 1, points_count() - 1);
+    invalidateGeometry();
     calculateBoundingRect();
 }
 
@@ -254,6 +307,7 @@ void Wire::move_point_to(int index, const QPointF& moveTo)
 {
     prepareGeometryChange();
     wire_system::wire::move_point_to(index, moveTo);
+    invalidateGeometry();
 
     Q_EMIT pointMoved(*this, wirePointsRelative()[index]);
     calculateBoundingRect();
@@ -302,13 +356,15 @@ void Wire::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 {
     Item::mouseReleaseEvent(event);
 
+    // Only look at the points the drag modified
+    simplify_modified();
+
     _pointToMoveIndex = -1;
     _lineSegmentToMoveIndex = -1;
     setMovable(true);
 
     // Store last known mouse pos
     _prevMousePos = event->scenePos();
-    simplify();
 }
 
 void Wire::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
@@ -318,7 +374,7 @@ void Wire::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 
     // Snap to grid (if supposed to)
     if (snapToGrid()) {
-        curPos = _settings.snapToGrid(curPos);
+        curPos = _settings->snapToGrid(curPos);
     }
 
     // Move a point?
@@ -350,7 +406,7 @@ void Wire::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 
         // Snap to grid (if supposed to)
         if (snapToGrid()) {
-            moveLineBy = _settings.snapToGrid(moveLineBy);
+            moveLineBy = _settings->snapToGrid(moveLineBy);
         }
 
         // Move line segment
@@ -455,8 +511,14 @@ void Wire::hoverMoveEvent(QGraphicsSceneHoverEvent* event)
 
 void Wire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
+    // Painted by the wire layer
+    if (isBatched())
+        return;
+
+    Item::paint(painter, option, widget);
+
+    // Level of detail
+    const qreal lod = levelOfDetail(*painter, option);
 
     QPen penLine;
     penLine.setStyle(Qt::SolidLine);
@@ -491,23 +553,23 @@ void Wire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
     brushHandle.setStyle(Qt::SolidPattern);
 
     // Draw the actual line
+    const Geometry& geo = geometry();
     painter->setPen(penLine);
     painter->setBrush(brushLine);
-    const auto& points = pointsRelative();
+    const auto& points = geo.pointsRelative;
     painter->drawPolyline(points.constData(), points.count());
 
     // Draw the junction poins
-    int junctionRadius = 4;
-    for (const point& wirePoint : wirePointsRelative()) {
-        if (wirePoint.is_junction()) {
-            painter->setPen(penJunction);
-            painter->setBrush(brushJunction);
-            painter->drawEllipse(wirePoint.toPointF(), junctionRadius, junctionRadius);
-        }
+    if (lod >= _settings->lodMinScaleSymbols && !geo.junctions.isEmpty()) {
+        int junctionRadius = 4;
+        painter->setPen(penJunction);
+        painter->setBrush(brushJunction);
+        for (int index : geo.junctions)
+            painter->drawEllipse(points.at(index), junctionRadius, junctionRadius);
     }
 
     // Draw the handles (if selected)
-    if (isSelected()) {
+    if (isSelected() && lod >= _settings->lodMinScaleDetails) {
         painter->setOpacity(0.5);
         painter->setPen(penHandle);
         painter->setBrush(brushHandle);
@@ -518,7 +580,7 @@ void Wire::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
     }
 
     // Draw debugging stuff
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::red);
         painter->setBrush(Qt::NoBrush);
         painter->drawRect(boundingRect());
@@ -535,7 +597,7 @@ QVariant Wire::itemChange(QGraphicsItem::GraphicsItemChange change, const QVaria
 
     case ItemPositionChange: {
         // Move the wire
-        QPointF newPos = QPointF(_settings.snapToGrid(value.toPointF())) + _offset;
+        QPointF newPos = QPointF(_settings->snapToGrid(value.toPointF())) + _offset;
         QVector2D movedBy = QVector2D(newPos - pos());
         move(movedBy);
         return newPos;
@@ -544,6 +606,11 @@ QVariant Wire::itemChange(QGraphicsItem::GraphicsItemChange change, const QVaria
         if (!scene()) {
             break;
         }
+        // Let the batch move the points to their connectors once everything moved
+        if (scene()->wire_manager()->is_batching()) {
+            scene()->wire_manager()->wire_moved(this);
+            break;
+        }
         // Move points to their connectors
         for (const auto& conn : scene()->connectors()) {
             bool isSelected = false;
@@ -600,7 +667,7 @@ void Wire::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
 
     // If the net is a WireNet, retrieve the label
     std::shared_ptr<Label> label;
-    if (auto wireNet = std::dynamic_pointer_cast<WireNet>(net())) {
+    if (auto wireNet = std::dynamic_pointer_cast<WireNet>(net()); wireNet && wireNet->hasLabel()) {
         label = wireNet->label();
     }
 
@@ -617,10 +684,10 @@ void Wire::contextMenuEvent(QGraphicsSceneContextMenuEvent* event)
 
     // Add a point at the cursor
     if (command == actionAdd) {
-        for (int i = 0; i < line_segments().count(); i++) {
-            if (line_segments().at(i).contains_point(event->scenePos(), 4)) {
+        for (int i = 0; i < line_segments_count(); i++) {
+            if (line_segment(i).contains_point(event->scenePos(), 4)) {
                 setSelected(true);
-                insert_point(i + 1, _settings.snapToGrid(event->scenePos()));
+                insert_point(i + 1, _settings->snapToGrid(event->scenePos()));
                 break;
             }
         }
@@ -659,23 +726,23 @@ void Wire::label_to_cursor(const QPointF& scenePos, std::shared_ptr<Label>& labe
     qreal angle = QLineF(seg.p1(), seg.p2()).angle();
     // When the wire is horizontal move the label up
     if (seg.is_horizontal()) {
-        pos.setY(seg.p1().y() - _settings.gridSize / 2);
+        pos.setY(seg.p1().y() - _settings->gridSize / 2);
     }
     // When the wire is vertical move the label to the right
     else if (seg.is_vertical()) {
-        pos.setX(seg.p1().x() + _settings.gridSize / 2);
+        pos.setX(seg.p1().x() + _settings->gridSize / 2);
     }
     // When the wire is diagonal with a positive slope move it up and to the left
     else if ((angle > 0 && angle < 90) || (angle > 180 && angle < 360)) {
         QPointF point = Utils::pointOnLineClosestToPoint(seg.p1(), seg.p2(), pos);
-        pos.setX(point.x() - _settings.gridSize / 2 - label->textRect().width());
-        pos.setY(point.y() - _settings.gridSize / 2);
+        pos.setX(point.x() - _settings->gridSize / 2 - label->textRect().width());
+        pos.setY(point.y() - _settings->gridSize / 2);
     }
     // When the wire is diagonal with a negative slope move it up and to the right
     else {
         QPointF point = Utils::pointOnLineClosestToPoint(seg.p1(), seg.p2(), pos);
-        pos.setX(point.x() + _settings.gridSize / 2);
-        pos.setY(point.y() - _settings.gridSize / 2);
+        pos.setX(point.x() + _settings->gridSize / 2);
+        pos.setY(point.y() - _settings->gridSize / 2);
     }
     label->setParentItem((QGraphicsItem*) this);
     label->setPos(pos - Wire::pos());
@@ -693,13 +760,35 @@ bool Wire::movingWirePoint() const
 void Wire::about_to_change()
 {
     prepareGeometryChange();
+    invalidateGeometry();
 }
 
 void Wire::has_changed()
 {
+    invalidateGeometry();
     calculateBoundingRect();
 }
 
+QGraphicsItem::CacheMode Wire::cacheModePolicy() const
+{
+    return static_cast<QGraphicsItem::CacheMode>(_settings->cacheModeWire);
+}
+
+bool Wire::pixmapCacheable() const
+{
+    // The built-in wires only paint their points. Subclasses may paint more than the attributes cover.
+    return type() == Item::WireType || type() == Item::WireRoundedCornersType || type() == Item::SplineWireType;
+}
+
+void Wire::pixmapCacheAttributes(QDataStream& stream) const
+{
+    Item::pixmapCacheAttributes(stream);
+
+    stream << isBatched();
+    for (const auto& point : wirePointsRelative())
+        stream << point.toPointF() << point.is_junction();
+}
+
 void Wire::add_segment(int index)
 {
     if (index == 0) {
@@ -708,6 +797,21 @@ void Wire::add_segment(int index)
     wire::add_segment(index);
 }
 
+bool Wire::batchable() const
+{
+    return true;
+}
+
+bool Wire::isBatched() const
+{
+    if (!_settings->batchWireRendering || !batchable() || isSelected() || isHighlighted())
+        return false;
+
+    const Scene* s = scene();
+
+    return s && s->wireLayer();
+}
+
 void Wire::rename_net()
 {
     if (_renameAction) {
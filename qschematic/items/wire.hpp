@@ -6,6 +6,7 @@
 #include "../wire_system/wire.hpp"
 
 #include <QAction>
+#include <QPainterPath>
 
 class QVector2D;
 
@@ -49,6 +50,30 @@ namespace QSchematic::Items
         bool movingWirePoint() const;
         void rename_net();
 
+        /**
+         * Whether this wire may be painted by the scene's wire layer.
+         *
+         * @note Sub-classes implementing custom painting must return `false`.
+         *
+         * @return Whether the wire can be painted by the wire layer.
+         */
+        [[nodiscard]]
+        virtual
+        bool
+        batchable() const;
+
+        /**
+         * Whether this wire is currently painted by the scene's wire layer instead of by itself.
+         *
+         * @details This is the case if batched wire rendering is enabled, the wire is batchable and it's neither
+         *          selected nor highlighted.
+         *
+         * @return Whether the wire is batched.
+         */
+        [[nodiscard]]
+        bool
+        isBatched() const;
+
     Q_SIGNALS:
         void pointMoved(Wire& wire, point& point);
         void toggleLabelRequested();
@@ -71,12 +96,40 @@ namespace QSchematic::Items
         void about_to_change() override;
         void has_changed() override;
         void add_segment(int index) override;
+        QGraphicsItem::CacheMode cacheModePolicy() const override;
+        bool pixmapCacheable() const override;
+        void pixmapCacheAttributes(QDataStream& stream) const override;
 
     private:
         Q_DISABLE_COPY_MOVE(Wire)
 
+        /**
+         * Cached geometry derived from the wire points.
+         *
+         * @details The cache is valid as long as its version matches the wire's geometry version and the wire did
+         *          not move. The stroked shape is only computed when it's queried.
+         */
+        struct Geometry
+        {
+            quint64 version = 0;
+            QPointF pos;
+            QVector<QPointF> pointsRelative;
+            QVector<point> wirePointsRelative;
+            QVector<int> junctions;
+            QRectF rect;
+            QPainterPath shape;
+            bool shapeValid = false;
+        };
+
         void label_to_cursor(const QPointF& scenePos, std::shared_ptr<Label>& label) const;
+        void invalidateGeometry();
+
+        [[nodiscard]]
+        const Geometry&
+        geometry() const;
 
+        quint64 _geometryVersion = 1;
+        mutable Geometry _geometry;
         QRectF _rect;
         int _pointToMoveIndex;
         int _lineSegmentToMoveIndex;
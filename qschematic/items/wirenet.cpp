@@ -18,20 +18,6 @@ using namespace QSchematic::Items;
 WireNet::WireNet(QObject* parent) :
     QObject(parent), _scene(nullptr)
 {
-    // Label
-    _label = std::make_shared<Label>();
-    _label->setPos(0, 0);
-    _label->setVisible(false);
-    connect(_label.get(), &Label::highlightChanged, this, &WireNet::labelHighlightChanged);
-    connect(_label.get(), &Label::moved, this, [this] { updateLabelPos(); });
-
-    // Rename net by double clicking on label
-    connect(_label.get(), &Label::doubleClicked, this, [this] {
-        Wire* wire = dynamic_cast<Wire*>(_label->parentItem());
-        if (wire) {
-            wire->rename_net();
-        }
-    });
 }
 
 WireNet::~WireNet()
@@ -54,12 +40,12 @@ void WireNet::save(Archive& ar, const unsigned int version) const
     std::string s = name().toStdString();
     ar& boost::serialization::make_nvp("name", s);
     // The coordinates of the label need to be in the scene space
-    if (_label->parentItem()) {
+    if (_label && _label->parentItem()) {
         _label->moveBy(QVector2D(_label->parentItem()->pos()));
     }
     ar& boost::serialization::make_nvp("label", _label);
     // Move the label back to the correct position
-    if (_label->parentItem()) {
+    if (_label && _label->parentItem()) {
         _label->moveBy(-QVector2D(_label->parentItem()->pos()));
     }
 }
@@ -75,7 +61,13 @@ void WireNet::load(Archive& ar, const unsigned int version)
     set_name(QString::fromStdString(name));
 
     // Label
+    if (_label) {
+        dissociate_item(_label);
+    }
     ar& boost::serialization::make_nvp("label", _label);
+    if (_label) {
+        connectLabel();
+    }
 }
 
 bool WireNet::addWire(const std::shared_ptr<wire>& wire)
@@ -110,18 +102,31 @@ bool WireNet::removeWire(const std::shared_ptr<wire> wire)
     return true;
 }
 
-void WireNet::simplify()
+/**
+ * Simplifies all wires of this net.
+ *
+ * @return Whether any of the wires changed.
+ */
+bool WireNet::simplify()
 {
+    bool changed = false;
     for (auto& wire : wires()) {
-        wire->simplify();
+        changed |= wire->simplify();
     }
+
+    return changed;
 }
 
 void WireNet::set_name(const QString& name)
 {
     net::set_name(name);
 
-    _label->setText(this->name());
+    // Unnamed nets don't need a label
+    if (!_label && this->name().isEmpty()) {
+        return;
+    }
+
+    ensureLabel()->setText(this->name());
     _label->setVisible(!this->name().isEmpty());
     updateLabelPos(true);
 }
@@ -140,7 +145,9 @@ void WireNet::setHighlighted(bool highlighted)
     }
 
     // Label
-    _label->setHighlighted(highlighted);
+    if (_label) {
+        _label->setHighlighted(highlighted);
+    }
 
 }
 
@@ -217,11 +224,54 @@ QList<QPointF> WireNet::points() const
     return list;
 }
 
-std::shared_ptr<Label> WireNet::label()
+/**
+ * Get the label of this net.
+ *
+ * @note Labels are only created once they're needed. Use ensureLabel() to get a label in any case.
+ *
+ * @return The label or nullptr if there is none (yet).
+ */
+std::shared_ptr<Label> WireNet::label() const
+{
+    return _label;
+}
+
+/**
+ * Get the label of this net, creating it if it doesn't exist yet.
+ *
+ * @return The label.
+ */
+std::shared_ptr<Label> WireNet::ensureLabel()
 {
+    if (!_label) {
+        _label = std::make_shared<Label>();
+        _label->setPos(0, 0);
+        _label->setVisible(false);
+        connectLabel();
+    }
+
     return _label;
 }
 
+bool WireNet::hasLabel() const
+{
+    return _label != nullptr;
+}
+
+void WireNet::connectLabel()
+{
+    connect(_label.get(), &Label::highlightChanged, this, &WireNet::labelHighlightChanged);
+    connect(_label.get(), &Label::moved, this, [this] { updateLabelPos(); });
+
+    // Rename net by double clicking on label
+    connect(_label.get(), &Label::doubleClicked, this, [this] {
+        Wire* wire = dynamic_cast<Wire*>(_label->parentItem());
+        if (wire) {
+            wire->rename_net();
+        }
+    });
+}
+
 void WireNet::wirePointMoved(Wire& wire, const point& point)
 {
     updateLabelPos();
@@ -233,7 +283,7 @@ void WireNet::wirePointMoved(Wire& wire, const point& point)
 void WireNet::updateLabelPos(bool updateParent) const
 {
     // Ignore if the label is not visible
-    if (!_label->isVisible()) {
+    if (!_label || !_label->isVisible()) {
         return;
     }
     // Find closest point
@@ -241,7 +291,8 @@ void WireNet::updateLabelPos(bool updateParent) const
     QPointF closestPoint;
     std::shared_ptr<wire> closestWire;
     for (const auto& wire : wires()) {
-        for (const auto& segment: wire->line_segments()) {
+        for (int i = 0; i < wire->line_segments_count(); i++) {
+            const auto segment = wire->line_segment(i);
             // Find closest point on segment
             QPointF p = Utils::pointOnLineClosestToPoint(segment.p1(), segment.p2(), labelPos);
             float distance1 = QVector2D(labelPos - closestPoint).lengthSquared();
@@ -287,6 +338,10 @@ void WireNet::wireHighlightChanged(const Item& item, bool highlighted)
 
 void WireNet::toggleLabel()
 {
+    if (!_label) {
+        return;
+    }
+
     _label->setVisible(!_label->text().isEmpty() && !_label->isVisible());
     updateLabelPos(true);
 }
@@ -51,7 +51,7 @@ namespace QSchematic::Items
 
         bool addWire(const std::shared_ptr<wire>& wire) override;
         bool removeWire(const std::shared_ptr<wire> wire) override;
-        void simplify();
+        bool simplify();
         void set_name(const QString& name) override;
         void setHighlighted(bool highlighted);
         void setScene(Scene* scene);
@@ -60,7 +60,9 @@ namespace QSchematic::Items
 
         QList<line> lineSegments() const;
         QList<QPointF> points() const;
-        std::shared_ptr<Label> label();
+        std::shared_ptr<Label> label() const;
+        std::shared_ptr<Label> ensureLabel();
+        bool hasLabel() const;
 
     Q_SIGNALS:
         void highlightChanged(bool highlighted);
@@ -74,8 +76,9 @@ namespace QSchematic::Items
     private:
         QList<std::shared_ptr<WireNet>> nets() const;
         void highlight_global_net(bool highlighted);
+        void connectLabel();
 
-        std::shared_ptr<Label> _label;
+        std::shared_ptr<Label> _label;      // Created on first use
         Scene* _scene{};
     };
 
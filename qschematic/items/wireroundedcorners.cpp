@@ -33,10 +33,14 @@ void WireRoundedCorners::serialize(Archive& ar, const unsigned int version)
     ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Wire);
 }
 
+bool WireRoundedCorners::batchable() const
+{
+    return false;
+}
+
 void WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
+    Item::paint(painter, option, widget);
 
     // Retrieve the scene points as we'll need them a lot
     auto sceneWirePoints(wirePointsRelative());
@@ -106,8 +110,8 @@ void WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem
 
                 // Find if there is a junction on this point
                 bool hasJunction = false;
-                for (const auto& wire: connected_wires()) {
-                    for (const auto& jIndex: wire->junctions()) {
+                for (const auto& wire: connected_wires_ref()) {
+                    for (const auto& jIndex: wire->junction_indexes()) {
                         const auto& junction = wire->points().at(jIndex);
                         if (junction.toPoint() == (point + pos()).toPoint()) {
                             hasJunction = true;
@@ -123,7 +127,7 @@ void WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem
                 QLineF line1(Utils::centerPoint(pPoint.toPoint(), point.toPoint()), point.toPoint());
                 QLineF line2(Utils::centerPoint(point.toPoint(), nPoint.toPoint()), point.toPoint());
 
-                int linePointAdjust = _settings.gridSize/2;
+                int linePointAdjust = _settings->gridSize/2;
                 // If one of the lines is smaller that linePointAdjust make its length the new linePointAdjust
                 if (line1.length() < linePointAdjust) {
                     linePointAdjust = line1.length();
@@ -182,7 +186,7 @@ void WireRoundedCorners::paint(QPainter* painter, const QStyleOptionGraphicsItem
     }
 
     // Draw debugging stuff
-    if (_settings.debug) {
+    if (_settings->debug) {
         painter->setPen(Qt::red);
         painter->setBrush(Qt::NoBrush);
         painter->drawRect(boundingRect());
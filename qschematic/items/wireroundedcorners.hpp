@@ -19,6 +19,7 @@ namespace QSchematic::Items
         template<class Archive>
         void serialize(Archive& ar, const unsigned int version);
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+        bool batchable() const override;
 
     private:
         enum QuarterCircleSegment {
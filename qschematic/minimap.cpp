@@ -0,0 +1,360 @@
+#include "minimap.hpp"
+#include "view.hpp"
+#include "scene.hpp"
+
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace QSchematic;
+
+// Edge length of a tile in pixels
+const int TILE_SIZE = 256;
+
+// Number of pyramid levels. Level n renders at a scale of 2^-n pixels per scene unit.
+const int LEVEL_COUNT = 16;
+
+// Default memory budget of the tile cache
+const qint64 DEFAULT_MAXIMUM_CACHE_BYTES = 8 * 1024 * 1024;
+
+// Minimum time between two scene changes marking the tiles as outdated
+const int CHANGE_INTERVAL_MS = 250;
+
+// Time budget for rendering tiles per event loop iteration
+const int RENDER_BUDGET_MS = 8;
+
+// Maximum number of changed regions kept until the tiles get marked. More regions are merged into one.
+const int MAX_CHANGED_RECTS = 64;
+
+namespace
+{
+
+    [[nodiscard]]
+    quint64
+    tileKey(int level, int column, int row)
+    {
+        // Columns & rows may be negative: Offset them into 28 bits each
+        const quint64 offset = quint64(1) << 27;
+        return (quint64(level) << 56) | ((quint64(column + offset) & 0xfffffff) << 28) | (quint64(row + offset) & 0xfffffff);
+    }
+
+    /**
+     * Get the level of a tile.
+     */
+    [[nodiscard]]
+    int
+    tileLevel(quint64 key)
+    {
+        return int(key >> 56);
+    }
+
+    [[nodiscard]]
+    QRectF
+    tileRect(int level, int column, int row)
+    {
+        const qreal size = TILE_SIZE * std::ldexp(1.0, level);
+
+        return { column * size, row * size, size, size };
+    }
+
+    [[nodiscard]]
+    QRectF
+    tileRect(quint64 key)
+    {
+        const qint64 offset = qint64(1) << 27;
+        const int level = tileLevel(key);
+        const int column = int(qint64((key >> 28) & 0xfffffff) - offset);
+        const int row = int(qint64(key & 0xfffffff) - offset);
+
+        return tileRect(level, column, row);
+    }
+
+}
+
+Minimap::Minimap(QWidget* parent) :
+    QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setCursor(Qt::PointingHandCursor);
+    setMaximumCacheBytes(DEFAULT_MAXIMUM_CACHE_BYTES);
+
+    m_changeTimer.setSingleShot(true);
+    m_changeTimer.setInterval(CHANGE_INTERVAL_MS);
+    connect(&m_changeTimer, &QTimer::timeout, this, &Minimap::markTilesOutdated);
+
+    m_renderTimer.setInterval(0);
+    connect(&m_renderTimer, &QTimer::timeout, this, &Minimap::renderPendingTiles);
+}
+
+void
+Minimap::setView(View* view)
+{
+    for (const auto& connection : m_connections)
+        disconnect(connection);
+    m_connections.clear();
+
+    m_view = view;
+    m_tiles.clear();
+    m_outdatedTiles.clear();
+    m_pendingTiles.clear();
+    m_changedRects.clear();
+    m_changeTimer.stop();
+    m_renderTimer.stop();
+    update();
+
+    if (!m_view)
+        return;
+
+    // Viewport rectangle
+    const auto& viewportChanged = [this]{ update(); };
+    m_connections << connect(m_view, &View::zoomChanged, this, viewportChanged);
+    m_connections << connect(m_view->horizontalScrollBar(), &QScrollBar::valueChanged, this, viewportChanged);
+    m_connections << connect(m_view->verticalScrollBar(), &QScrollBar::valueChanged, this, viewportChanged);
+
+    // Scene content
+    // Note: This deliberately doesn't use QGraphicsScene::changed() as connecting to it disables the direct update
+    //       path of all views and it fires for every hover & selection change.
+    if (auto scene = qobject_cast<Scene*>(m_view->scene())) {
+        m_connections << connect(scene, &Scene::regionChanged, this, &Minimap::sceneChanged);
+        m_connections << connect(scene, &QGraphicsScene::sceneRectChanged, this, viewportChanged);
+    }
+}
+
+void
+Minimap::setMaximumCacheBytes(qint64 bytes)
+{
+    m_tiles.setMaxCost(int(std::clamp<qint64>(bytes / 1024, 1, std::numeric_limits<int>::max())));
+}
+
+void
+Minimap::invalidate()
+{
+    m_changeTimer.stop();
+    m_changedRects.clear();
+
+    // Keep showing the tiles until they're rendered again
+    for (const quint64 key : m_tiles.keys())
+        m_outdatedTiles.insert(key);
+
+    update();
+}
+
+QSize
+Minimap::sizeHint() const
+{
+    return { 200, 150 };
+}
+
+void
+Minimap::sceneChanged(const QRectF& rect)
+{
+    if (rect.isNull())
+        return;
+
+    // Bound the bookkeeping while dragging many items
+    if (m_changedRects.count() >= MAX_CHANGED_RECTS) {
+        QRectF united = rect;
+        for (const QRectF& changedRect : std::as_const(m_changedRects))
+            united |= changedRect;
+        m_changedRects = { united };
+    }
+    else
+        m_changedRects << rect;
+
+    // Coalesce: The first change starts the timer, all changes until it fires are handled at once
+    if (!m_changeTimer.isActive())
+        m_changeTimer.start();
+}
+
+/**
+ * Marks the cached tiles intersecting the changed regions as outdated.
+ */
+void
+Minimap::markTilesOutdated()
+{
+    if (m_changedRects.isEmpty())
+        return;
+
+    bool marked = false;
+    for (const quint64 key : m_tiles.keys()) {
+        if (m_outdatedTiles.contains(key))
+            continue;
+
+        // Antialiasing reaches one pixel of the tile beyond the item bounds
+        const qreal pixel = std::ldexp(1.0, tileLevel(key));
+        const QRectF& rect = tileRect(key).adjusted(-pixel, -pixel, pixel, pixel);
+        const bool changed = std::any_of(m_changedRects.cbegin(), m_changedRects.cend(), [&rect](const QRectF& changedRect) {
+            return changedRect.intersects(rect);
+        });
+        if (!changed)
+            continue;
+
+        // Keep showing the tile until it's rendered again
+        m_outdatedTiles.insert(key);
+        marked = true;
+    }
+    m_changedRects.clear();
+
+    if (marked)
+        update();
+}
+
+void
+Minimap::renderPendingTiles()
+{
+    if (!m_view || !m_view->scene()) {
+        m_pendingTiles.clear();
+        m_renderTimer.stop();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!m_pendingTiles.isEmpty() && timer.elapsed() < RENDER_BUDGET_MS) {
+        const quint64 key = m_pendingTiles.takeFirst();
+        const QRectF& rect = tileRect(key);
+
+        // Render
+        auto pixmap = new QPixmap(TILE_SIZE, TILE_SIZE);
+        pixmap->fill(palette().color(QPalette::Base));
+        {
+            QPainter painter(pixmap);
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            m_view->scene()->render(&painter, QRectF(0, 0, TILE_SIZE, TILE_SIZE), rect, Qt::IgnoreAspectRatio);
+        }
+
+        const int cost = std::max(1, int(qint64(TILE_SIZE) * TILE_SIZE * pixmap->depth() / 8 / 1024));
+        m_tiles.insert(key, pixmap, cost);
+        m_outdatedTiles.remove(key);
+    }
+
+    if (m_pendingTiles.isEmpty())
+        m_renderTimer.stop();
+
+    update();
+}
+
+std::optional<QTransform>
+Minimap::sceneToWidget() const
+{
+    if (!m_view || !m_view->scene())
+        return std::nullopt;
+
+    // Fit the scene rect into the widget
+    const QRectF& sceneRect = m_view->scene()->sceneRect();
+    if (sceneRect.isEmpty())
+        return std::nullopt;
+    const qreal scale = std::min(width() / sceneRect.width(), height() / sceneRect.height());
+    const QPointF offset((width() - sceneRect.width() * scale) / 2, (height() - sceneRect.height() * scale) / 2);
+
+    QTransform transform;
+    transform.translate(offset.x(), offset.y());
+    transform.scale(scale, scale);
+    transform.translate(-sceneRect.x(), -sceneRect.y());
+
+    return transform;
+}
+
+/**
+ * Get a tile for painting.
+ *
+ * @details This never renders. Missing & outdated tiles are queued for rendering instead.
+ *
+ * @return The (possibly outdated) tile or `nullptr` if it wasn't rendered yet.
+ */
+const QPixmap*
+Minimap::tile(int level, int column, int row)
+{
+    const quint64 key = tileKey(level, column, row);
+    const QPixmap* pixmap = m_tiles.object(key);
+
+    if ((!pixmap || m_outdatedTiles.contains(key)) && !m_pendingTiles.contains(key)) {
+        m_pendingTiles << key;
+        m_renderTimer.start();
+    }
+
+    return pixmap;
+}
+
+void
+Minimap::paintEvent([[maybe_unused]] QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().color(QPalette::Window));
+
+    const auto& transform = sceneToWidget();
+    if (!transform)
+        return;
+
+    // Pick the level closest to (but not below) the displayed scale
+    const qreal scale = transform->m11();
+    const int level = std::clamp(int(std::floor(-std::log2(scale))), 0, LEVEL_COUNT - 1);
+
+    // Tiles
+    // Only the tiles of the displayed level are (re-)rendered, the queue gets rebuilt below.
+    m_pendingTiles.clear();
+    const QRectF& sceneRect = m_view->scene()->sceneRect();
+    const qreal tileSize = TILE_SIZE * std::ldexp(1.0, level);
+    const int firstColumn = int(std::floor(sceneRect.left() / tileSize));
+    const int lastColumn = int(std::floor(sceneRect.right() / tileSize));
+    const int firstRow = int(std::floor(sceneRect.top() / tileSize));
+    const int lastRow = int(std::floor(sceneRect.bottom() / tileSize));
+
+    painter.save();
+    painter.setTransform(*transform);
+    painter.setClipRect(sceneRect);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            if (const QPixmap* pixmap = tile(level, column, row))
+                painter.drawPixmap(tileRect(level, column, row), *pixmap, QRectF(pixmap->rect()));
+        }
+    }
+    painter.restore();
+
+    // Viewport
+    const QRectF& viewportRect = m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 2));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(transform->mapRect(viewportRect));
+}
+
+void
+Minimap::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    navigateTo(event->pos());
+    event->accept();
+}
+
+void
+Minimap::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!(event->buttons() & Qt::LeftButton)) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    navigateTo(event->pos());
+    event->accept();
+}
+
+void
+Minimap::navigateTo(const QPointF& widgetPos)
+{
+    const auto& transform = sceneToWidget();
+    if (!transform)
+        return;
+
+    m_view->centerOn(transform->inverted().map(widgetPos));
+}
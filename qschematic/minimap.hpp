@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QCache>
+#include <QMetaObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+
+#include <optional>
+
+namespace QSchematic
+{
+
+    class View;
+
+    /**
+     * An overview of the scene displayed in a View.
+     *
+     * @details The scene is rendered into a pyramid of low-resolution tiles. Each level has half the resolution of the
+     *          previous one and the level closest to the displayed scale is used. Tiles are never rendered while
+     *          painting: Missing & outdated tiles are queued and rendered in small batches from the event loop. Until
+     *          then, outdated tiles keep being shown.
+     *          Edits of the scene (added, removed, moved & resized items, see Scene::regionChanged()) are coalesced
+     *          and mark the cached tiles intersecting the changed regions as outdated at most a few times per second.
+     *          This covers direct edits as well as the ones made through the undo stack. Transient changes like hover
+     *          or selection highlights are ignored. Therefore, the minimap does not cause any rendering while the scene
+     *          is idle.
+     *          The viewport of the view is shown as a rectangle. Clicking or dragging centers the view on that point.
+     */
+    class Minimap :
+        public QWidget
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(Minimap)
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param parent The parent widget.
+         */
+        explicit
+        Minimap(QWidget* parent = nullptr);
+
+        /**
+         * Destructor.
+         */
+        ~Minimap() override = default;
+
+        /**
+         * Set the view.
+         *
+         * @details The minimap shows the scene of the view.
+         *
+         * @param view The view. May be `nullptr`.
+         */
+        void
+        setView(View* view);
+
+        /**
+         * Set the memory budget of the tile cache.
+         *
+         * @param bytes The maximum number of bytes.
+         */
+        void
+        setMaximumCacheBytes(qint64 bytes);
+
+        /**
+         * Mark all cached tiles as outdated.
+         *
+         * @details The tiles are rendered again in the background. Use this if the scene changed in a way the
+         *          minimap doesn't pick up by itself (eg. appearance changes which don't touch the geometry of an item).
+         */
+        void
+        invalidate();
+
+        [[nodiscard]]
+        QSize
+        sizeHint() const override;
+
+    protected:
+        void paintEvent(QPaintEvent* event) override;
+        void mousePressEvent(QMouseEvent* event) override;
+        void mouseMoveEvent(QMouseEvent* event) override;
+
+    private:
+        void
+        sceneChanged(const QRectF& rect);
+
+        void
+        markTilesOutdated();
+
+        void
+        renderPendingTiles();
+
+        void
+        navigateTo(const QPointF& widgetPos);
+
+        [[nodiscard]]
+        std::optional<QTransform>
+        sceneToWidget() const;
+
+        [[nodiscard]]
+        const QPixmap*
+        tile(int level, int column, int row);
+
+        QPointer<View> m_view;
+        QVector<QMetaObject::Connection> m_connections;
+        QCache<quint64, QPixmap> m_tiles;   // Cost: KiB
+        QSet<quint64> m_outdatedTiles;      // Cached tiles which are still shown until they're rendered again
+        QVector<quint64> m_pendingTiles;    // Tiles waiting to be rendered
+        QVector<QRectF> m_changedRects;     // Scene regions changed since the tiles were marked as outdated last
+        QTimer m_changeTimer;               // Coalesces scene changes
+        QTimer m_renderTimer;               // Renders the pending tiles
+    };
+
+}
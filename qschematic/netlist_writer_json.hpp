@@ -31,7 +31,7 @@ namespace QSchematic
             for (const auto& [connector, node] : net.connectorNodePairs) {
                 QJsonObject connection;
                 connection.insert(QStringLiteral("node"), node->text());
-                connection.insert(QStringLiteral("connector"), connector->label()->text());  // ToDo: Nullptr check
+                connection.insert(QStringLiteral("connector"), connector->text());
                 connectionsArray.append(connection);
             }
             netObject.insert(QStringLiteral("connections"), connectionsArray);
@@ -4,15 +4,27 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsProxyWidget>
 #include <QUndoStack>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QImage>
 #include <QMimeData>
+#include <QPdfWriter>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <QStyleOptionGraphicsItem>
+#include <QtEndian>
 #include <QtMath>
 #include <QTimer>
 
 #include "scene.hpp"
 #include "background.hpp"
+#include "wire_layer.hpp"
+#include "commands/base.hpp"
 #include "commands/item_move.hpp"
 #include "commands/item_add.hpp"
 #include "commands/item_remove.hpp"
+#include "commands/items_add.hpp"
 #include "items/item.hpp"
 #include "items/itemmimedata.hpp"
 #include "items/node.hpp"
@@ -23,13 +35,190 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+
 using namespace QSchematic;
 
+namespace
+{
+
+    /**
+     * Magic bytes identifying a tiled scene file.
+     */
+    constexpr char TILES_MAGIC[4] = { 'Q', 'S', 'T', 'L' };
+
+    /**
+     * Magic bytes & format version prefixed to the MIME_TYPE_ITEMS clipboard blob.
+     *
+     * @note Bump the version whenever the Clipboard layout changes so that data copied from another build of the
+     *       library gets rejected instead of misparsed.
+     */
+    constexpr char CLIPBOARD_MAGIC[4] = { 'Q', 'S', 'C', 'B' };
+    constexpr quint32 CLIPBOARD_VERSION = 1;
+
+    /**
+     * An entry of the tile index.
+     */
+    struct TileIndexEntry
+    {
+        int column = 0;
+        int row = 0;
+        qreal x = 0;                // Bounds of the tile's content
+        qreal y = 0;
+        qreal width = 0;
+        qreal height = 0;
+        std::uint64_t offset = 0;   // Relative to the end of the index
+        std::uint64_t size = 0;
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            Q_UNUSED(version)
+
+            ar & boost::serialization::make_nvp("column", column);
+            ar & boost::serialization::make_nvp("row", row);
+            ar & boost::serialization::make_nvp("x", x);
+            ar & boost::serialization::make_nvp("y", y);
+            ar & boost::serialization::make_nvp("width", width);
+            ar & boost::serialization::make_nvp("height", height);
+            ar & boost::serialization::make_nvp("offset", offset);
+            ar & boost::serialization::make_nvp("size", size);
+        }
+
+        [[nodiscard]]
+        QRectF
+        bounds() const
+        {
+            return { x, y, width, height };
+        }
+    };
+
+    /**
+     * The tile index written at the beginning of a tiled scene file.
+     */
+    struct TileIndex
+    {
+        int sceneX = 0;
+        int sceneY = 0;
+        int sceneWidth = 0;
+        int sceneHeight = 0;
+        int tileSize = 0;
+        std::vector<TileIndexEntry> tiles;
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            Q_UNUSED(version)
+
+            ar & boost::serialization::make_nvp("scene_x", sceneX);
+            ar & boost::serialization::make_nvp("scene_y", sceneY);
+            ar & boost::serialization::make_nvp("scene_width", sceneWidth);
+            ar & boost::serialization::make_nvp("scene_height", sceneHeight);
+            ar & boost::serialization::make_nvp("tile_size", tileSize);
+            ar & boost::serialization::make_nvp("tiles", tiles);
+        }
+    };
+
+    /**
+     * The part of a net living in one tile.
+     *
+     * @details Only the tile owning the net carries the actual net. All other tiles carry a stub made of the id and the
+     *          name of the net.
+     */
+    struct TileNet
+    {
+        int id = -1;
+        std::string name;
+        std::shared_ptr<Items::WireNet> net;
+        std::vector<std::shared_ptr<Items::Wire>> wires;
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            Q_UNUSED(version)
+
+            ar & boost::serialization::make_nvp("id", id);
+            ar & boost::serialization::make_nvp("name", name);
+            ar & boost::serialization::make_nvp("net", net);
+            ar & boost::serialization::make_nvp("wires", wires);
+        }
+    };
+
+    /**
+     * The content of one tile.
+     */
+    struct Tile
+    {
+        std::vector<std::shared_ptr<Items::Item>> nodes;
+        std::vector<TileNet> nets;
+        QRectF bounds;
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            Q_UNUSED(version)
+
+            ar & boost::serialization::make_nvp("nodes", nodes);
+            ar & boost::serialization::make_nvp("nets", nets);
+        }
+    };
+
+    /**
+     * The content of the MIME_TYPE_ITEMS clipboard format.
+     */
+    struct Clipboard
+    {
+        qreal originX = 0;          // Top-left corner of the copied items
+        qreal originY = 0;
+        std::vector<std::shared_ptr<Items::Item>> items;
+        std::map<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>> nets;
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            Q_UNUSED(version)
+
+            ar & boost::serialization::make_nvp("origin_x", originX);
+            ar & boost::serialization::make_nvp("origin_y", originY);
+            ar & boost::serialization::make_nvp("items", items);
+            ar & boost::serialization::make_nvp("nets", nets);
+        }
+    };
+
+    using TileKey = std::pair<int, int>;
+
+    [[nodiscard]]
+    TileKey
+    tileKey(const QPointF& point, int tileSize)
+    {
+        return {
+            static_cast<int>(std::floor(point.x() / tileSize)),
+            static_cast<int>(std::floor(point.y() / tileSize))
+        };
+    }
+
+    /**
+     * Scene bounding rect of an item including its children.
+     */
+    [[nodiscard]]
+    QRectF
+    itemSceneBounds(const QGraphicsItem& item)
+    {
+        return item.sceneBoundingRect().united(item.mapRectToScene(item.childrenBoundingRect()));
+    }
+
+}
+
 Scene::Scene(QObject* parent) :
     QGraphicsScene(parent)
 {
@@ -47,6 +236,7 @@ Scene::Scene(QObject* parent) :
     connect(_undoStack, &QUndoStack::cleanChanged, [this](bool isClean) {
         Q_EMIT isDirtyChanged(!isClean);
     });
+    connect(_undoStack, &QUndoStack::indexChanged, this, &Scene::enforceUndoMemoryBudget);
 
     // Popup timer
     _popupTimer = new QTimer(this);
@@ -62,8 +252,9 @@ Scene::Scene(QObject* parent) :
         _popup->setPos(_lastMousePos + QPointF{ 5, 5 });
     });
 
-    // Background
+    // Background & wire layer
     setupBackground();
+    setupWireLayer();
     connect(this, &QGraphicsScene::sceneRectChanged, [this](const QRectF rect){
         if (_background) {
             // Note: We adjust the scene rect (make it smaller) before we set it as the background rect because the scene automatically resizes
@@ -71,6 +262,13 @@ Scene::Scene(QObject* parent) :
             //       triggering this slot again and we'd end up in an infinite loop.
             _background->setRect(rect.adjusted(1, 1, -1, -1));
         }
+
+        if (_wireLayer)
+            _wireLayer->setRect(rect.adjusted(1, 1, -1, -1));
+
+        // The views cache the background
+        if (_detachedBackground)
+            invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
     });
 }
 
@@ -138,10 +336,9 @@ void Scene::save(Archive& ar, const unsigned int version) const
 template<class Archive>
 void QSchematic::Scene::load(Archive& ar, const unsigned int version)
 {
-    // Scene
+    // Rect
+    QRect rect;
     {
-        // Rect
-        QRect rect;
         int x;
         ar& boost::serialization::make_nvp("scene_x", x);
         rect.setX(x);
@@ -154,66 +351,431 @@ void QSchematic::Scene::load(Archive& ar, const unsigned int version)
         int height;
         ar& boost::serialization::make_nvp("scene_height", height);
         rect.setHeight(height);
+    }
 
-        setSceneRect(rect);
+    // Nodes
+    std::vector<std::shared_ptr<Items::Item>> nodes;
+    ar& boost::serialization::make_nvp("nodes", nodes);
+
+    // Nets
+    std::vector<std::pair<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>>> nets;
+    {
+        std::vector<std::shared_ptr<Items::WireNet>> wireNets;
+        ar& boost::serialization::make_nvp("nets", wireNets);
+        std::map<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>> nets_wire;
+        ar& boost::serialization::make_nvp("nets_wire", nets_wire);
+
+        nets.reserve(wireNets.size());
+        for (auto& net : wireNets)
+            nets.emplace_back(net, std::move(nets_wire[net]));
     }
 
+    addContent(rect, nodes, nets);
+}
+
+bool
+Scene::saveTiles(std::ostream& stream, const int tileSize) const
+{
+    // Sanity check
+    if (tileSize <= 0)
+        return false;
+
+    std::map<TileKey, Tile> tiles;
+
     // Nodes
+    for (const auto& node : nodes()) {
+        const QRectF bounds = itemSceneBounds(*node);
+        auto& tile = tiles[tileKey(bounds.center(), tileSize)];
+        tile.nodes.push_back(node);
+        tile.bounds = tile.bounds.united(bounds);
+    }
+
+    // Nets
+    int netId = 0;
+    for (const auto& net : m_wire_manager->nets()) {
+        // Make sure it's a WireNet
+        auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net);
+        if (!wireNet)
+            continue;
+
+        // Distribute the wires over the tiles. The net itself is stored in the tile of its first wire.
+        std::map<TileKey, TileNet> fragments;
+        std::optional<TileKey> ownerKey;
+        for (const auto& wire : wireNet->wires()) {
+            auto wireItem = std::dynamic_pointer_cast<Items::Wire>(wire);
+            if (!wireItem)
+                continue;
+
+            const QRectF bounds = itemSceneBounds(*wireItem);
+            const TileKey key = tileKey(bounds.center(), tileSize);
+            if (!ownerKey)
+                ownerKey = key;
+
+            auto& fragment = fragments[key];
+            fragment.wires.push_back(wireItem);
+            tiles[key].bounds = tiles[key].bounds.united(bounds);
+        }
+
+        for (auto& [key, fragment] : fragments) {
+            fragment.id = netId;
+            fragment.name = wireNet->name().toStdString();
+            if (key == ownerKey)
+                fragment.net = wireNet;
+            tiles[key].nets.push_back(std::move(fragment));
+        }
+
+        netId++;
+    }
+
+    // Serialize each tile on its own
+    TileIndex index;
     {
-        std::vector<std::shared_ptr<Items::Item>> nodes;
-        ar& boost::serialization::make_nvp("nodes", nodes);
-        for (const auto& node : nodes) {
-            addItem(node);
+        const QRect& rect = sceneRect().toRect();
+        index.sceneX = rect.x();
+        index.sceneY = rect.y();
+        index.sceneWidth = rect.width();
+        index.sceneHeight = rect.height();
+        index.tileSize = tileSize;
+    }
+    index.tiles.reserve(tiles.size());
+
+    std::vector<std::string> blobs;
+    blobs.reserve(tiles.size());
+    std::uint64_t offset = 0;
+    for (const auto& [key, tile] : tiles) {
+        std::ostringstream tileStream;
+        {
+            boost::archive::binary_oarchive oa(tileStream, boost::archive::archive_flags::no_header);
+            oa << boost::serialization::make_nvp("tile", tile);
         }
+        blobs.push_back(tileStream.str());
+
+        TileIndexEntry entry;
+        entry.column = key.first;
+        entry.row = key.second;
+        entry.x = tile.bounds.x();
+        entry.y = tile.bounds.y();
+        entry.width = tile.bounds.width();
+        entry.height = tile.bounds.height();
+        entry.offset = offset;
+        entry.size = blobs.back().size();
+        index.tiles.push_back(entry);
+
+        offset += entry.size;
     }
 
-    // Nets
+    // Serialize the index
+    std::ostringstream indexStream;
     {
-        std::vector<std::shared_ptr<Items::WireNet>> nets;
-        /*int nets_s;
-        ar & boost::serialization::make_nvp("nets_size", nets_s);
-        nets.reserve(nets_s);
-        for (int i = 0; i < nets_s; i++) {
-            auto ptr = std::make_shared<Items::WireNet>();
-            nets.push_back(ptr);
-            ptr->setScene(this);
-            ptr->set_manager(wire_manager().get());
-        }*/
-        ar& boost::serialization::make_nvp("nets", nets);
-        std::map<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>> nets_wire;
-        ar& boost::serialization::make_nvp("nets_wire", nets_wire);
-        for (auto& net : nets) {
-            net->setScene(this);
-            net->set_manager(wire_manager().get());
-            for (auto& wire : nets_wire[net]) {
+        boost::archive::binary_oarchive oa(indexStream, boost::archive::archive_flags::no_header);
+        oa << boost::serialization::make_nvp("index", index);
+    }
+    const std::string indexBlob = indexStream.str();
+
+    // Write everything
+    const quint64 indexSize = qToLittleEndian(static_cast<quint64>(indexBlob.size()));
+    stream.write(TILES_MAGIC, sizeof(TILES_MAGIC));
+    stream.write(reinterpret_cast<const char*>(&indexSize), sizeof(indexSize));
+    stream.write(indexBlob.data(), static_cast<std::streamsize>(indexBlob.size()));
+    for (const auto& blob : blobs)
+        stream.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+
+    return stream.good();
+}
+
+bool
+Scene::loadTiles(std::istream& stream, const QRectF& region)
+{
+    // Header
+    char magic[sizeof(TILES_MAGIC)];
+    quint64 indexSize = 0;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&indexSize), sizeof(indexSize));
+    if (!stream || !std::equal(std::begin(magic), std::end(magic), std::begin(TILES_MAGIC)))
+        return false;
+    indexSize = qFromLittleEndian(indexSize);
+
+    // Index
+    TileIndex index;
+    QByteArray file;
+    {
+        std::string indexBlob(indexSize, '\0');
+        if (!stream.read(indexBlob.data(), static_cast<std::streamsize>(indexBlob.size())))
+            return false;
+
+        std::istringstream indexStream(indexBlob);
+        try {
+            boost::archive::binary_iarchive ia(indexStream, boost::archive::archive_flags::no_header);
+            ia >> boost::serialization::make_nvp("index", index);
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+
+        // Identify the file by its index. Tile keys & net ids are only unique within a file.
+        file = QCryptographicHash::hash(QByteArray::fromStdString(indexBlob), QCryptographicHash::Sha1);
+    }
+    const std::streampos tilesBase = stream.tellg();
+
+    // Scene rect (only when loading the first tiles)
+    if (_loadedTiles.empty())
+        setSceneRect(QRect(index.sceneX, index.sceneY, index.sceneWidth, index.sceneHeight));
+
+    // Tiles
+    bool loadedAny = false;
+    for (const auto& entry : index.tiles) {
+        const TileKey key{ entry.column, entry.row };
+
+        // Skip tiles we don't need
+        if (_loadedTiles.contains({ file, key }))
+            continue;
+        if (!entry.bounds().intersects(region))
+            continue;
+
+        // Read the tile
+        Tile tile;
+        {
+            std::string tileBlob(entry.size, '\0');
+            stream.seekg(tilesBase + static_cast<std::streamoff>(entry.offset));
+            if (!stream.read(tileBlob.data(), static_cast<std::streamsize>(tileBlob.size())))
+                return false;
+
+            std::istringstream tileStream(tileBlob);
+            try {
+                boost::archive::binary_iarchive ia(tileStream, boost::archive::archive_flags::no_header);
+                ia >> boost::serialization::make_nvp("tile", tile);
+            }
+            catch (const std::exception&) {
+                return false;
+            }
+        }
+        _loadedTiles.insert({ file, key });
+        loadedAny = true;
+
+        // Nodes
+        for (const auto& node : tile.nodes)
+            addItem(node);
+
+        // Nets
+        for (auto& fragment : tile.nets) {
+            auto& net = _tileNets[{ file, fragment.id }];
+
+            // This tile owns the net: Replace the stub we might have created previously
+            if (fragment.net) {
+                if (net && net != fragment.net) {
+                    for (const auto& wire : net->wires()) {
+                        fragment.net->addWire(wire);
+                        net->removeWire(wire);
+                    }
+                    m_wire_manager->remove_net(net);
+                }
+                net = fragment.net;
+                net->setScene(this);
+                net->set_manager(m_wire_manager.get());
+                m_wire_manager->add_net(net);
+            }
+
+            // Only a stub: Create a placeholder net unless we already have one
+            else if (!net) {
+                net = std::make_shared<Items::WireNet>();
+                net->setScene(this);
+                net->set_manager(m_wire_manager.get());
+                net->set_name(QString::fromStdString(fragment.name));
+                m_wire_manager->add_net(net);
+            }
+
+            for (const auto& wire : fragment.wires) {
                 net->addWire(wire);
-                this->addItem(wire);
+                addItem(wire);
             }
-            m_wire_manager->add_net(net);
         }
+    }
+
+    if (loadedAny) {
+        // Attach the wires to the nodes
+        generateConnections();
+
+        // Find junctions
+        m_wire_manager->generate_junctions();
 
+        // Clear the undo history
+        _undoStack->clear();
     }
 
-    // Attach the wires to the nodes
-    generateConnections();
+    return true;
+}
 
-    // Find junctions
-    m_wire_manager->generate_junctions();
+bool
+Scene::exportTiles(const QString& directory, const ExportOptions& options, const QByteArray& format)
+{
+    const auto& tiles = exportTileRects(options);
+    if (tiles.empty())
+        return false;
 
-    // Clear the undo history
-    _undoStack->clear();
+    // Output directory
+    const QDir dir(directory);
+    if (!dir.mkpath(QStringLiteral(".")))
+        return false;
+
+    // Bound the number of tiles held in memory
+    const int maxPendingTiles = options.maxPendingTiles > 0 ? options.maxPendingTiles : std::max(1, QThread::idealThreadCount());
+    QSemaphore pendingTiles(maxPendingTiles);
+    std::atomic<bool> success = true;
+
+    for (const auto& [target, source] : tiles) {
+        pendingTiles.acquire();
+
+        // Render
+        QImage image(target.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(options.backgroundColor);
+        {
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing, _settings.antialiasing);
+            painter.setRenderHint(QPainter::TextAntialiasing, _settings.antialiasing);
+            render(&painter, QRectF(image.rect()), source, Qt::IgnoreAspectRatio);
+        }
+
+        // Encode & write
+        const int tileSize = std::max(1, options.tileSize);
+        const QString path = dir.filePath(QStringLiteral("%1_%2.%3").arg(target.y() / tileSize).arg(target.x() / tileSize).arg(QString::fromLatin1(format)));
+        QThreadPool::globalInstance()->start([image = std::move(image), path, format, &pendingTiles, &success] {
+            if (!image.save(path, format.constData()))
+                success = false;
+            pendingTiles.release();
+        });
+    }
+
+    // Wait for all tiles to be written
+    pendingTiles.acquire(maxPendingTiles);
+    pendingTiles.release(maxPendingTiles);
+
+    return success;
+}
+
+bool
+Scene::exportPdf(const QString& filePath, const ExportOptions& options)
+{
+    const auto& tiles = exportTileRects(options);
+    if (tiles.empty())
+        return false;
+
+    // One device unit equals one point
+    QPdfWriter writer(filePath);
+    writer.setResolution(72);
+    writer.setPageMargins(QMarginsF(0, 0, 0, 0));
+    writer.setPageSize(QPageSize(tiles.front().first.size(), QPageSize::Point));
+
+    QPainter painter;
+    if (!painter.begin(&writer))
+        return false;
+    painter.setRenderHint(QPainter::Antialiasing, _settings.antialiasing);
+    painter.setRenderHint(QPainter::TextAntialiasing, _settings.antialiasing);
+
+    bool firstPage = true;
+    for (const auto& [target, source] : tiles) {
+        // New page
+        if (!firstPage) {
+            writer.setPageSize(QPageSize(target.size(), QPageSize::Point));
+            if (!writer.newPage())
+                return false;
+        }
+        firstPage = false;
+
+        // Render
+        const QRectF page(QPointF(0, 0), target.size());
+        painter.fillRect(page, options.backgroundColor);
+        render(&painter, page, source, Qt::IgnoreAspectRatio);
+    }
+
+    return painter.end();
+}
+
+std::vector<std::pair<QRect, QRectF>>
+Scene::exportTileRects(const ExportOptions& options) const
+{
+    // Sanity check
+    if (options.scale <= 0 || options.tileSize <= 0)
+        return { };
+
+    // Source
+    QRectF source = options.sourceRect;
+    if (source.isNull()) {
+        for (const auto& item : _items)
+            source = source.united(itemSceneBounds(*item));
+    }
+    if (source.isEmpty())
+        return { };
+
+    // Split into tiles
+    const QSize size(qCeil(source.width() * options.scale), qCeil(source.height() * options.scale));
+    std::vector<std::pair<QRect, QRectF>> tiles;
+    tiles.reserve(std::size_t((size.width() / options.tileSize + 1) * (size.height() / options.tileSize + 1)));
+    for (int y = 0; y < size.height(); y += options.tileSize) {
+        for (int x = 0; x < size.width(); x += options.tileSize) {
+            const QRect target(x, y, std::min(options.tileSize, size.width() - x), std::min(options.tileSize, size.height() - y));
+            const QRectF tileSource(
+                source.x() + target.x() / options.scale,
+                source.y() + target.y() / options.scale,
+                target.width() / options.scale,
+                target.height() / options.scale
+            );
+            tiles.emplace_back(target, tileSource);
+        }
+    }
+
+    return tiles;
 }
 
 void
 Scene::setSettings(const Settings& settings)
 {
+    const bool backgroundModeChanged = settings.drawBackgroundInScene != _settings.drawBackgroundInScene;
+    const bool wireLayerChanged = settings.batchWireRendering != _settings.batchWireRendering;
+
     // Update background
     if (_background)
         _background->setSettings(settings);
 
-    // Update settings of all items
-    for (auto& item : items())
-        item->setSettings(settings);
+    // Update wire layer
+    if (_wireLayer)
+        _wireLayer->setSettings(settings);
+
+    // Settings which require the items to update their geometry or state
+    const bool itemsNeedUpdate =
+        settings.gridSize != _settings.gridSize ||
+        settings.highlightRectPadding != _settings.highlightRectPadding ||
+        settings.resizeHandleSize != _settings.resizeHandleSize ||
+        settings.cacheModeNode != _settings.cacheModeNode ||
+        settings.cacheModeLabel != _settings.cacheModeLabel ||
+        settings.cacheModeConnector != _settings.cacheModeConnector ||
+        settings.cacheModeWire != _settings.cacheModeWire;
+
+    // Settings which only change how the items are painted
+    const bool itemsNeedRepaint =
+        itemsNeedUpdate ||
+        settings.debug != _settings.debug ||
+        settings.antialiasing != _settings.antialiasing ||
+        settings.lodMinScaleText != _settings.lodMinScaleText ||
+        settings.lodMinScaleSymbols != _settings.lodMinScaleSymbols ||
+        settings.lodMinScaleDetails != _settings.lodMinScaleDetails;
+
+    // Update the settings shared by all items. This is O(1).
+    _sharedSettings.set(settings);
+
+    // Let the items react if necessary
+    if (itemsNeedUpdate) {
+        for (auto& item : items())
+            item->setSettings(_sharedSettings);
+    }
+
+    // Cached items keep painting their pixmap until they're updated explicitly, QGraphicsScene::update() doesn't
+    // invalidate the item caches.
+    if (itemsNeedRepaint) {
+        for (QGraphicsItem* item : QGraphicsScene::items()) {
+            if (item->cacheMode() != QGraphicsItem::NoCache)
+                item->update();
+        }
+    }
 
     // Update settings of the wire manager
     m_wire_manager->set_settings(settings);
@@ -221,7 +783,20 @@ Scene::setSettings(const Settings& settings)
     // Store new settings
     _settings = settings;
 
+    // Switch between background item & drawing the background from the scene
+    if (backgroundModeChanged) {
+        removeBackground();
+        setupBackground();
+    }
+
+    // Add or remove the wire layer
+    if (wireLayerChanged) {
+        removeWireLayer();
+        setupWireLayer();
+    }
+
     // Redraw
+    invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
     update();
 }
 
@@ -306,18 +881,28 @@ Scene::clear()
     // we still need them as we manage them via smart pointers (eg. in commands)
     while (!_items.isEmpty())
         removeItem(_items.first());
+    _itemsBounds.clear();
 
     // Nets
     m_wire_manager->clear();
 
+    // Tiles
+    _loadedTiles.clear();
+    _tileNets.clear();
+
     // Now that all the top-level items are safeguarded we can call the underlying scene's clear()
+    // Note: This deletes the background item (if any).
     QGraphicsScene::clear();
+    _background = nullptr;
+    _detachedBackground.reset();
+    _wireLayer = nullptr;
 
     // No longer dirty
     clearIsDirty();
 
     // Setup the background again
     setupBackground();
+    setupWireLayer();
 }
 
 bool
@@ -336,6 +921,12 @@ Scene::addItem(const std::shared_ptr<Items::Item>& item)
     // Store the shared pointer to keep the item alive for the QGraphicsScene
     _items << item;
 
+    // Track the bounds
+    updateItemBounds(*item);
+    connect(item.get(), &Items::Item::moved, this, [this](const Items::Item& movedItem) { updateItemBounds(movedItem); });
+    connect(item.get(), &Items::Item::rotated, this, [this](const Items::Item& rotatedItem) { updateItemBounds(rotatedItem); });
+    connect(item.get(), &Items::Item::geometryChanged, this, &Scene::updateItemBounds);
+
     // Let the world know
     Q_EMIT itemAdded(item);
     Q_EMIT netlistChanged();
@@ -343,6 +934,49 @@ Scene::addItem(const std::shared_ptr<Items::Item>& item)
     return true;
 }
 
+void
+Scene::addContent(
+    const QRect& rect,
+    const std::vector<std::shared_ptr<Items::Item>>& nodes,
+    const std::vector<std::pair<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>>>& nets
+)
+{
+    setSceneRect(rect);
+
+    // Reserve once for all nodes & wires
+    {
+        std::size_t count = nodes.size();
+        for (const auto& [net, wires] : nets)
+            count += wires.size();
+        _items.reserve(_items.size() + static_cast<int>(count));
+    }
+
+    // Nodes
+    for (const auto& node : nodes)
+        addItem(node);
+
+    // Nets
+    m_wire_manager->reserve_nets(static_cast<int>(nets.size()));
+    for (const auto& [net, wires] : nets) {
+        net->setScene(this);
+        net->set_manager(m_wire_manager.get());
+        for (const auto& wire : wires) {
+            net->addWire(wire);
+            addItem(wire);
+        }
+        m_wire_manager->add_net(net);
+    }
+
+    // Attach the wires to the nodes
+    generateConnections();
+
+    // Find junctions
+    m_wire_manager->generate_junctions();
+
+    // Clear the undo history
+    _undoStack->clear();
+}
+
 bool
 Scene::removeItem(const std::shared_ptr<Items::Item> item)
 {
@@ -363,10 +997,23 @@ Scene::removeItem(const std::shared_ptr<Items::Item> item)
     // Remove shared pointer from local list to reduce instance count
     _items.removeAll(item);
 
+    // Stop tracking the bounds
+    disconnect(item.get(), &Items::Item::moved, this, nullptr);
+    disconnect(item.get(), &Items::Item::rotated, this, nullptr);
+    disconnect(item.get(), &Items::Item::geometryChanged, this, nullptr);
+    const QRectF& oldBounds = _itemsBounds.rect(item.get());
+    _itemsBounds.remove(item.get());
+    if (_wireLayer) {
+        if (auto wire = dynamic_cast<const Items::Wire*>(item.get()); wire)
+            _wireLayer->removeWire(*wire);
+    }
+
     // Update the corresponding scene area (redraw)
     update(itemBoundsToUpdate);
 
     // Let the world know
+    if (!oldBounds.isNull())
+        Q_EMIT regionChanged(oldBounds);
     Q_EMIT itemRemoved(item);
     Q_EMIT netlistChanged();
 
@@ -387,6 +1034,143 @@ Scene::isBackground(const QGraphicsItem* item) const
     return dynamic_cast<const Background*>(item) == _background;
 }
 
+WireLayer*
+Scene::wireLayer() const
+{
+    return _wireLayer;
+}
+
+void
+Scene::moveItems(const QVector<std::shared_ptr<Items::Item>>& items, const QVector2D& moveBy)
+{
+    // Translate everything while deferring the attached wire updates
+    m_wire_manager->begin_batch();
+    for (const auto& item : items)
+        item->moveBy(moveBy);
+    m_wire_manager->end_batch();
+
+    // Simplify the points that got moved (including the ones of the attached wires)
+    for (const auto& wire : m_wire_manager->wires())
+        wire->simplify_modified();
+}
+
+QMimeData*
+Scene::copySelection() const
+{
+    Clipboard clipboard;
+    QRectF bounds;
+    for (const auto& item : selectedTopLevelItems()) {
+        bounds = bounds.united(itemSceneBounds(*item));
+
+        // Wires are grouped by their nets
+        if (auto wire = std::dynamic_pointer_cast<Items::Wire>(item)) {
+            if (auto net = std::dynamic_pointer_cast<Items::WireNet>(wire->net()))
+                clipboard.nets[net].push_back(std::move(wire));
+            continue;
+        }
+
+        clipboard.items.push_back(item);
+    }
+    if (clipboard.items.empty() && clipboard.nets.empty())
+        return nullptr;
+    clipboard.originX = bounds.x();
+    clipboard.originY = bounds.y();
+
+    // Serialize (keep the archive header so that the Boost archive version & type sizes get checked as well)
+    std::ostringstream stream;
+    const quint32 version = qToLittleEndian(CLIPBOARD_VERSION);
+    stream.write(CLIPBOARD_MAGIC, sizeof(CLIPBOARD_MAGIC));
+    stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    try {
+        boost::archive::binary_oarchive oa(stream);
+        oa << boost::serialization::make_nvp("clipboard", clipboard);
+    }
+    catch (const std::exception&) {
+        return nullptr;
+    }
+
+    const std::string& blob = stream.str();
+    auto mimeData = new QMimeData;
+    mimeData->setData(Items::MIME_TYPE_ITEMS, QByteArray(blob.data(), static_cast<int>(blob.size())));
+
+    return mimeData;
+}
+
+bool
+Scene::paste(const QMimeData& mimeData, const QPointF& pos)
+{
+    if (!mimeData.hasFormat(Items::MIME_TYPE_ITEMS))
+        return false;
+
+    // Header
+    const QByteArray& blob = mimeData.data(Items::MIME_TYPE_ITEMS);
+    std::istringstream stream(blob.toStdString());
+    char magic[sizeof(CLIPBOARD_MAGIC)];
+    quint32 version = 0;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!stream || !std::equal(std::begin(magic), std::end(magic), std::begin(CLIPBOARD_MAGIC)))
+        return false;
+    if (qFromLittleEndian(version) != CLIPBOARD_VERSION)
+        return false;
+
+    // Deserialize
+    Clipboard clipboard;
+    try {
+        boost::archive::binary_iarchive ia(stream);
+        ia >> boost::serialization::make_nvp("clipboard", clipboard);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+
+    // Move everything to the requested position
+    const QVector2D moveBy(_settings.snapToGrid(pos - QPointF(clipboard.originX, clipboard.originY)));
+    for (const auto& item : clipboard.items)
+        item->moveBy(moveBy);
+
+    // Wires are added to their nets by the command
+    std::vector<std::shared_ptr<Items::Wire>> wires;
+    for (const auto& [net, netWires] : clipboard.nets) {
+        for (const auto& wire : netWires) {
+            wire->setNet(net);
+            wire->moveBy(moveBy);
+            wires.push_back(wire);
+        }
+    }
+    if (clipboard.items.empty() && wires.empty())
+        return false;
+
+    _undoStack->push(new Commands::ItemsAdd(this, std::move(clipboard.items), std::move(wires)));
+
+    return true;
+}
+
+QRectF
+Scene::itemsBounds() const
+{
+    return _itemsBounds.bounds();
+}
+
+void
+Scene::updateItemBounds(const Items::Item& item)
+{
+    const QRectF& bounds = itemSceneBounds(item);
+    const QRectF& oldBounds = _itemsBounds.rect(&item);
+    _itemsBounds.insert(&item, bounds);
+    if (_wireLayer) {
+        if (auto wire = dynamic_cast<const Items::Wire*>(&item); wire)
+            _wireLayer->insertWire(*wire, bounds);
+    }
+
+    // Grow the scene rect. Setting it explicitly keeps QGraphicsScene from recomputing the bounding rect of all items.
+    const QRectF& rect = sceneRect();
+    if (!bounds.isNull() && !rect.contains(bounds))
+        setSceneRect(rect.united(bounds));
+
+    Q_EMIT regionChanged(oldBounds.united(bounds));
+}
+
 QList<std::shared_ptr<Items::Item>>
 Scene::items() const
 {
@@ -515,6 +1299,76 @@ Scene::undoStack() const
     return _undoStack;
 }
 
+void
+Scene::setUndoMemoryBudget(std::size_t bytes)
+{
+    _undoMemoryBudget = bytes;
+
+    enforceUndoMemoryBudget();
+}
+
+std::size_t
+Scene::undoMemoryBudget() const
+{
+    return _undoMemoryBudget;
+}
+
+void
+Scene::setUndoCompactionDepth(int steps)
+{
+    _undoCompactionDepth = steps;
+
+    enforceUndoMemoryBudget();
+}
+
+int
+Scene::undoCompactionDepth() const
+{
+    return _undoCompactionDepth;
+}
+
+std::size_t
+Scene::undoMemoryFootprint() const
+{
+    std::size_t bytes = 0;
+    for (int i = 0; i < _undoStack->count(); i++) {
+        if (auto command = dynamic_cast<const Commands::Base*>(_undoStack->command(i)))
+            bytes += command->memoryFootprint();
+        else
+            bytes += sizeof(QUndoCommand);
+    }
+
+    return bytes;
+}
+
+void
+Scene::enforceUndoMemoryBudget()
+{
+    // Commands which got undone restore themselves. Also, the stack might have been cleared.
+    _undoCompactedCount = std::min(_undoCompactedCount, _undoStack->index());
+
+    if (_undoMemoryBudget == 0 && _undoCompactionDepth < 0)
+        return;
+
+    // Compact the oldest commands first. Always keep the most recent command as-is since it might still get merged.
+    const int depthLimit = _undoCompactionDepth < 0 ? 0 : _undoStack->index() - _undoCompactionDepth;
+    std::size_t bytes = _undoMemoryBudget > 0 ? undoMemoryFootprint() : 0;
+    while (_undoCompactedCount < _undoStack->count() - 1) {
+        const bool overBudget = _undoMemoryBudget > 0 && bytes > _undoMemoryBudget;
+        if (!overBudget && _undoCompactedCount >= depthLimit)
+            break;
+
+        auto command = dynamic_cast<Commands::Base*>(const_cast<QUndoCommand*>(_undoStack->command(_undoCompactedCount)));
+        _undoCompactedCount++;
+        if (!command)
+            continue;
+
+        const std::size_t before = command->memoryFootprint();
+        command->compact();
+        bytes -= std::min(bytes, before - std::min(before, command->memoryFootprint()));
+    }
+}
+
 std::shared_ptr<wire_system::manager>
 Scene::wire_manager() const
 {
@@ -693,13 +1547,8 @@ Scene::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
                         updateNodeConnections(node);
                 }
 
-                for (auto& item : m_wire_manager->wires()) {
-                    Items::Wire* wire = dynamic_cast<Items::Wire*>(item.get());
-                    if (wire) {
-                        // wire->updatePosition();
-                        wire->simplify();
-                    }
-                }
+                for (const auto& wire : m_wire_manager->wires())
+                    wire->simplify_modified();
             }
             break;
         }
@@ -762,6 +1611,8 @@ Scene::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
                         }
                     );
 
+                    // Defer the attached wire updates until everything is at its new position
+                    m_wire_manager->begin_batch();
                     for (const auto& item : itemsToMove) {
                         // Calculate by how much the item was moved
                         QVector2D moveBy{ _initialItemPositions.value(item) + newMousePos - _initialCursorPosition - item->pos() };
@@ -770,10 +1621,11 @@ Scene::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
                         moveBy = itemsMoveSnap(item, moveBy);
                         item->setPos(item->pos() + moveBy.toPointF());
                     }
+                    m_wire_manager->end_batch();
 
-                    // Simplify all the wires
-                    for (auto& wire : m_wire_manager->wires())
-                        wire->simplify();
+                    // Simplify the points that got moved
+                    for (const auto& wire : m_wire_manager->wires())
+                        wire->simplify_modified();
                 }
                 else
                     QGraphicsScene::mouseMoveEvent(event);
@@ -931,6 +1783,7 @@ Scene::dragEnterEvent(QGraphicsSceneDragDropEvent* event)
     // Create a list of mime formats we can handle
     QStringList mimeFormatsWeCanHandle {
         Items::MIME_TYPE_NODE,
+        Items::MIME_TYPE_ITEMS,
     };
 
     // Check whether we can handle this drag/drop
@@ -983,6 +1836,28 @@ Scene::dropEvent(QGraphicsSceneDragDropEvent* event)
         item->setPos(event->scenePos());
         _undoStack->push(new Commands::ItemAdd(this, std::move(item)));
     }
+
+    // Serialized items
+    else if (mimeData->hasFormat(Items::MIME_TYPE_ITEMS))
+        paste(*mimeData, event->scenePos());
+}
+
+void
+Scene::drawBackground(QPainter* painter, const QRectF& rect)
+{
+    QGraphicsScene::drawBackground(painter, rect);
+
+    // Sanity check
+    if (!_detachedBackground)
+        return;
+
+    // Let the background paint the exposed part of the scene
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = rect.intersected(_detachedBackground->rect());
+    if (option.exposedRect.isEmpty())
+        return;
+
+    _detachedBackground->paint(painter, &option, nullptr);
 }
 
 std::unique_ptr<Background>
@@ -1011,6 +1886,14 @@ Scene::setupBackground()
     bg->setZValue(z_value_background);
     bg->setSettings(_settings);
 
+    // Keep the background out of the scene. It gets painted from drawBackground() instead.
+    if (_settings.drawBackgroundInScene) {
+        _detachedBackground = std::move(bg);
+        _background = _detachedBackground.get();
+        invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
+        return;
+    }
+
     // Bookkeeping
     _background = bg.release();
 
@@ -1018,6 +1901,53 @@ Scene::setupBackground()
     QGraphicsScene::addItem(_background);
 }
 
+void
+Scene::removeBackground()
+{
+    if (!_background)
+        return;
+
+    if (_detachedBackground)
+        _detachedBackground.reset();
+    else {
+        QGraphicsScene::removeItem(_background);
+        delete _background;
+    }
+
+    _background = nullptr;
+}
+
+void
+Scene::setupWireLayer()
+{
+    if (!_settings.batchWireRendering)
+        return;
+
+    _wireLayer = new WireLayer(*this);
+    _wireLayer->setRect(sceneRect());
+    _wireLayer->setZValue(z_value_wire_layer);
+    _wireLayer->setSettings(_settings);
+
+    // Track the wires which are already in the scene
+    for (const auto& item : _items) {
+        if (auto wire = dynamic_cast<const Items::Wire*>(item.get()); wire)
+            _wireLayer->insertWire(*wire, itemSceneBounds(*wire));
+    }
+
+    QGraphicsScene::addItem(_wireLayer);
+}
+
+void
+Scene::removeWireLayer()
+{
+    if (!_wireLayer)
+        return;
+
+    QGraphicsScene::removeItem(_wireLayer);
+    delete _wireLayer;
+    _wireLayer = nullptr;
+}
+
 void
 Scene::updateNodeConnections(const Items::Node* node)
 {
@@ -1032,17 +1962,22 @@ Scene::updateNodeConnections(const Items::Node* node)
             continue;
 
         // Find if there is a point to connect to
+        const QPoint connectorPos = connector->scenePos().toPoint();
         for (const auto& wire : m_wire_manager->wires()) {
+            const auto& points = wire->points();
+            if (points.isEmpty())
+                continue;
+
             int index = -1;
 
-            if (wire->points().first().toPoint() == connector->scenePos().toPoint())
+            if (points.first().toPoint() == connectorPos)
                 index = 0;
-            else if (wire->points().last().toPoint() == connector->scenePos().toPoint())
-                index = wire->points().count() - 1;
+            else if (points.last().toPoint() == connectorPos)
+                index = points.count() - 1;
 
             if (index != -1) {
                 // Ignore if it's a junction
-                if (wire->points().at(index).is_junction())
+                if (points.at(index).is_junction())
                     continue;
 
                 // Check if it isn't already connected to another connector
@@ -1103,8 +2038,8 @@ Scene::wirePointMoved(wire& rawWire, int index)
 void
 Scene::setupNewItem(Items::Item& item)
 {
-    // Set settings
-    item.setSettings(_settings);
+    // Share settings
+    item.setSettings(_sharedSettings);
 }
 
 void
@@ -1244,14 +2179,14 @@ Scene::removeUnconnectedWires()
 
     for (const auto& wire : m_wire_manager->wires()) {
         // If it has wires attached to it, go to the next wire
-        if (wire->connected_wires().count() > 0)
+        if (wire->connected_wires_ref().count() > 0)
             continue;
 
         bool isConnected = false;
 
         // Check if it is connected to a wire
         for (const auto& otherWire : m_wire_manager->wires()) {
-            if (otherWire->connected_wires().contains(wire.get())) {
+            if (otherWire->connected_wires_ref().contains(wire.get())) {
                 isConnected = true;
                 break;
             }
@@ -4,17 +4,24 @@
 #include "items/item.hpp"
 #include "items/wire.hpp"
 #include "wire_system/manager.hpp"
+#include "utils/boundstracker.hpp"
 //#include "utils/itemscustodian.h"
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/split_member.hpp>
 
+#include <QColor>
 #include <QGraphicsScene>
 #include <QUndoStack>
 
 #include <algorithm>
+#include <iosfwd>
+#include <map>
 #include <memory>
 #include <functional>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace QSchematic
 {
@@ -27,7 +34,13 @@ namespace QSchematic
         class WireNet;
     }
 
+    namespace Commands
+    {
+        class ItemsAdd;
+    }
+
     class Background;
+    class WireLayer;
 
     /**
      * The QSchematic Scene.
@@ -41,8 +54,11 @@ namespace QSchematic
         Q_OBJECT
         Q_DISABLE_COPY_MOVE(Scene)
 
+        friend class Commands::ItemsAdd;
+
     public:
         qreal z_value_background = -10'000;
+        qreal z_value_wire_layer = -11;     // Below the wires
 
         enum Mode {
             NormalMode,
@@ -52,6 +68,18 @@ namespace QSchematic
         };
         Q_ENUM(Mode)
 
+        /**
+         * Options for the tiled export.
+         */
+        struct ExportOptions
+        {
+            QRectF sourceRect;                      // Region to export (scene coordinates). Null: Bounds of all items.
+            qreal scale = 1.0;                      // Pixels per scene unit
+            int tileSize = 2048;                    // Edge length of a tile in pixels
+            int maxPendingTiles = 0;                // Max. number of rendered tiles waiting to be written. 0: Number of cores.
+            QColor backgroundColor = Qt::white;
+        };
+
         explicit Scene(QObject* parent = nullptr);
         ~Scene() override;
 
@@ -80,6 +108,85 @@ namespace QSchematic
         void
         clear();
 
+        /**
+         * Saves the scene partitioned into spatial tiles.
+         *
+         * @details Nodes and wires are bucketed into square cells of @p tileSize scene units (by the center of their
+         *          scene bounding rect). Each tile is written as an independent binary archive, preceded by a tile index
+         *          holding the cell, the bounds of the tile's content and its byte range. This allows loadTiles() to
+         *          seek straight to the tiles it needs.
+         *          Nets spanning several tiles are stored in the tile holding their first wire. All other tiles only
+         *          carry a lightweight stub consisting of the net id and name.
+         *
+         * @param stream The output stream. Must be opened in binary mode.
+         * @param tileSize The edge length of a tile in scene units.
+         * @return Success indicator.
+         */
+        bool
+        saveTiles(std::ostream& stream, int tileSize = 4096) const;
+
+        /**
+         * Loads the tiles of a tiled scene file which intersect a region.
+         *
+         * @details Tiles that were already loaded from the same file are skipped. This allows calling this repeatedly
+         *          as the user navigates through the scene. Files are told apart by their tile index, so tiles of
+         *          several files can be loaded into the same scene. Net stubs are merged with the full net once the
+         *          tile holding it gets loaded.
+         *
+         * @note The bookkeeping of loaded tiles is reset by clear().
+         *
+         * @param stream The input stream of a file written by saveTiles(). Must be opened in binary mode.
+         * @param region The region of interest in scene coordinates.
+         * @return Success indicator.
+         */
+        bool
+        loadTiles(std::istream& stream, const QRectF& region);
+
+        /**
+         * Exports the scene into image tiles.
+         *
+         * @details The export region is split into tiles of ExportOptions::tileSize pixels. Each tile is rendered into
+         *          its own QImage and handed to the global thread pool which encodes and writes it. Only
+         *          ExportOptions::maxPendingTiles tiles are held in memory at any time. The tiles are written as
+         *          `<row>_<column>.<format>` into @p directory.
+         *          This only uses raster paint devices and therefore works headless (eg. with the offscreen QPA).
+         *          No single stitched image is written: QImageWriter can't write an image incrementally, so that would
+         *          require holding the entire export in memory.
+         *
+         * @note The tiles are rendered on the calling thread as QGraphicsScene is not thread-safe. Only the encoding
+         *       and writing happen in parallel.
+         *
+         * @param directory The output directory. Gets created if necessary.
+         * @param options The export options.
+         * @param format The image format (as supported by QImageWriter, eg. "png" or "tiff").
+         * @return Success indicator.
+         */
+        bool
+        exportTiles(const QString& directory, const ExportOptions& options = { }, const QByteArray& format = "png");
+
+        /**
+         * Exports the scene into a PDF file.
+         *
+         * @details The export region is split into tiles like exportTiles() does. Each tile becomes one page which is
+         *          rendered as vector graphics. The page size in points matches the tile size in pixels.
+         *
+         * @param filePath The path of the PDF file.
+         * @param options The export options.
+         * @return Success indicator.
+         */
+        bool
+        exportPdf(const QString& filePath, const ExportOptions& options = { });
+
+        /**
+         * Compute the tiles of an export as done by exportTiles() and exportPdf().
+         *
+         * @param options The export options.
+         * @return Pairs of the tile rect in pixels & the corresponding source rect in scene coordinates.
+         */
+        [[nodiscard]]
+        std::vector<std::pair<QRect, QRectF>>
+        exportTileRects(const ExportOptions& options) const;
+
         /**
          * Adds an item to the scene.
          *
@@ -95,6 +202,26 @@ namespace QSchematic
         bool
         addItem(const std::shared_ptr<Items::Item>& item);
 
+        /**
+         * Adds the content of a loaded scene.
+         *
+         * @details This sets the scene rect, adds the nodes as well as the nets & their wires, attaches the wires to the
+         *          connectors, finds the junctions and clears the undo history. The item storage is reserved once for
+         *          all nodes & wires. This is used by the deserialization code.
+         *
+         * @note The scene should be cleared before calling this.
+         *
+         * @param rect The scene rect.
+         * @param nodes The nodes.
+         * @param nets The nets, each with the wires it consists of.
+         */
+        void
+        addContent(
+            const QRect& rect,
+            const std::vector<std::shared_ptr<Items::Item>>& nodes,
+            const std::vector<std::pair<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>>>& nets
+        );
+
         /**
          * Removes an item from the scene.
          *
@@ -160,6 +287,70 @@ namespace QSchematic
         bool
         isBackground(const QGraphicsItem* item) const;
 
+        /**
+         * Get the wire layer.
+         *
+         * @note The wire layer only exists if Settings::batchWireRendering is enabled.
+         *
+         * @return The wire layer (if any).
+         */
+        [[nodiscard]]
+        WireLayer*
+        wireLayer() const;
+
+        /**
+         * Get the combined bounds of all top-level items (including their children).
+         *
+         * @details The bounds are maintained incrementally as items are added, removed, moved, rotated or change their
+         *          geometry. Retrieving them is O(1). The scene rect grows to contain these bounds.
+         *
+         * @return The bounds in scene coordinates. A null rect if the scene has no items.
+         */
+        [[nodiscard]]
+        QRectF
+        itemsBounds() const;
+
+        /**
+         * Move several items at once.
+         *
+         * @details All items are translated first. The wire points attached to connectors of the moved items are
+         *          updated afterwards so that each of them moves exactly once and no intermediate wire states occur.
+         *          Finally, each moved wire gets simplified once.
+         *
+         * @param items The items to move.
+         * @param moveBy The translation.
+         */
+        void
+        moveItems(const QVector<std::shared_ptr<Items::Item>>& items, const QVector2D& moveBy);
+
+        /**
+         * Serialize the selected items for the clipboard or a drag.
+         *
+         * @details The selected top-level items as well as the selected wires (grouped by their nets) are serialized
+         *          into a single binary blob of the Items::MIME_TYPE_ITEMS format. No item is copied in memory. The
+         *          blob starts with a format tag & version and can be pasted into any scene, including one of another
+         *          process as long as it uses the same clipboard format version.
+         *
+         * @return The mime data. The caller takes ownership. `nullptr` if nothing is selected or the selection
+         *         cannot be serialized.
+         */
+        [[nodiscard]]
+        QMimeData*
+        copySelection() const;
+
+        /**
+         * Insert items from mime data created by copySelection().
+         *
+         * @details The blob is only deserialized at this point. Everything gets inserted through a single
+         *          Commands::ItemsAdd command.
+         *
+         * @param mimeData The mime data.
+         * @param pos The position of the top-left corner of the inserted items (scene coordinates).
+         * @return Success indicator. `false` if the blob has another format tag or version.
+         */
+        bool
+        paste(const QMimeData& mimeData, const QPointF& pos);
+
         QList<std::shared_ptr<Items::Item>> itemsAt(const QPointF& scenePos, Qt::SortOrder order = Qt::DescendingOrder) const;
         std::vector<std::shared_ptr<Items::Item>> selectedItems() const;
         std::vector<std::shared_ptr<Items::Item>> selectedTopLevelItems() const;
@@ -199,6 +390,61 @@ namespace QSchematic
         QUndoStack*
         undoStack() const;
 
+        /**
+         * Set the memory budget of the undo stack.
+         *
+         * @details Once the commands on the undo stack exceed the budget, the oldest commands get compacted (see
+         *          Commands::Base::compact()) until the stack fits into the budget again. Commands holding items
+         *          which are no longer part of the scene and large wire point moves write their data to a temporary
+         *          file when compacted.
+         *
+         * @note The budget is best-effort: Compacted commands still take up some memory and the most recent command
+         *       is never compacted. QUndoStack does not allow removing individual commands, so the stack can stay
+         *       over budget. Use QUndoStack::setUndoLimit() to put a hard cap on the number of commands.
+         *
+         * @param bytes The budget in bytes. 0 disables the budget.
+         */
+        void
+        setUndoMemoryBudget(std::size_t bytes);
+
+        /**
+         * Get the memory budget of the undo stack.
+         *
+         * @return The budget in bytes. 0 if disabled.
+         */
+        [[nodiscard]]
+        std::size_t
+        undoMemoryBudget() const;
+
+        /**
+         * Set the depth after which commands on the undo stack get compacted.
+         *
+         * @details Commands which are more than @p steps below the current undo stack index get compacted regardless
+         *          of the memory budget. They're restored transparently when they get undone.
+         *
+         * @param steps The number of steps. Negative values disable this.
+         */
+        void
+        setUndoCompactionDepth(int steps);
+
+        /**
+         * Get the depth after which commands on the undo stack get compacted.
+         *
+         * @return The number of steps. Negative if disabled.
+         */
+        [[nodiscard]]
+        int
+        undoCompactionDepth() const;
+
+        /**
+         * Get the approximate amount of memory held by the commands on the undo stack.
+         *
+         * @return The number of bytes.
+         */
+        [[nodiscard]]
+        std::size_t
+        undoMemoryFootprint() const;
+
     Q_SIGNALS:
         void modeChanged(int newMode);
         void isDirtyChanged(bool isDirty);
@@ -206,6 +452,19 @@ namespace QSchematic
         void itemRemoved(std::shared_ptr<Items::Item> item);
         void itemHighlighted(const std::shared_ptr<const Items::Item>& item);
 
+        /**
+         * Signal to indicate that the content of a region of the scene changed.
+         *
+         * @details This is emitted when a top-level item is added, removed, moved, rotated or changes its geometry. It
+         *          is emitted for edits made through the undo stack as well as for direct ones.
+         *
+         * @note Changes of the appearance which don't touch the geometry of an item (eg. highlights) are not reported.
+         *
+         * @param rect The affected region in scene coordinates (the old & the new bounds of the item).
+         */
+        void
+        regionChanged(const QRectF& rect);
+
         /**
          * Signal to indicate that the netlist has likely changed.
          *
@@ -217,6 +476,7 @@ namespace QSchematic
 
     protected:
         Settings _settings;
+        SharedSettings _sharedSettings{ Settings() };    // Shared with all items
 
         // QGraphicsScene
         void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
@@ -227,12 +487,16 @@ namespace QSchematic
         void dragMoveEvent(QGraphicsSceneDragDropEvent* event) override;
         void dragLeaveEvent(QGraphicsSceneDragDropEvent* event) override;
         void dropEvent(QGraphicsSceneDragDropEvent* event) override;
+        void drawBackground(QPainter* painter, const QRectF& rect) override;
 
         /**
          * Factory function to make a background item.
          *
          * Sub-classes may re-implement this to provide their own implementations.
          *
+         * @note If Settings::drawBackgroundInScene is set, the background is not added to the scene. Instead, it gets
+         *       painted from drawBackground().
+         *
          * @return The background item.
          */
         [[nodiscard]]
@@ -254,6 +518,9 @@ namespace QSchematic
 
     private:
         void setupBackground();
+        void removeBackground();
+        void setupWireLayer();
+        void removeWireLayer();
         void setupNewItem(Items::Item& item);
         void updateNodeConnections(const Items::Node* node);
         void generateConnections();
@@ -271,6 +538,17 @@ namespace QSchematic
         std::shared_ptr<Items::Wire>
         make_wire() const;
 
+        /**
+         * Update the tracked bounds of a top-level item & grow the scene rect if necessary.
+         *
+         * @param item The item.
+         */
+        void
+        updateItemBounds(const Items::Item& item);
+
+        void
+        enforceUndoMemoryBudget();
+
         // TODO add to "central" sh-ptr management
         QList<std::shared_ptr<Items::Item>> _keep_alive_an_event_loop;
 
@@ -281,6 +559,7 @@ namespace QSchematic
          * not be in the list.
          */
         QList<std::shared_ptr<Items::Item>> _items;
+        ItemUtils::BoundsTracker _itemsBounds;
 
         // Note: haven't investigated destructor specification, but it seems
         // this can be skipped, although it would be: explicit, more efficient,
@@ -300,11 +579,18 @@ namespace QSchematic
         QMap<std::shared_ptr<Items::Item>, QPointF> _initialItemPositions;
         QPointF _initialCursorPosition;
         QUndoStack* _undoStack = nullptr;
+        std::size_t _undoMemoryBudget = 0;
+        int _undoCompactionDepth = -1;
+        int _undoCompactedCount = 0;  // Number of commands (from the bottom of the stack) which have been compacted
         std::shared_ptr<wire_system::manager> m_wire_manager;
         std::shared_ptr<Items::Item> _highlightedItem = nullptr;
         QTimer* _popupTimer = nullptr;
         std::shared_ptr<QGraphicsProxyWidget> _popup;
         Background* _background = nullptr;
+        std::unique_ptr<Background> _detachedBackground;  // Owner of the background if it's not added to the scene
+        WireLayer* _wireLayer = nullptr;
+        std::set<std::pair<QByteArray, std::pair<int, int>>> _loadedTiles;             // By file & tile
+        std::map<std::pair<QByteArray, int>, std::shared_ptr<Items::WireNet>> _tileNets;  // By file & net id
     };
 
 }
@@ -0,0 +1,1186 @@
+#include "scene_xml.hpp"
+#include "scene.hpp"
+#include "items/connector.hpp"
+#include "items/label.hpp"
+#include "items/node.hpp"
+#include "items/symbol.hpp"
+#include "items/wire.hpp"
+#include "items/wirenet.hpp"
+#include "items/wireroundedcorners.hpp"
+
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/serialization/version.hpp>
+
+#include <QIODevice>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <typeinfo>
+
+using namespace QSchematic;
+
+namespace
+{
+
+    /**
+     * The names the built-in types are exported to Boost with.
+     */
+    constexpr const char* NODE_CLASS_NAME = "QSchematic::Items::Node";
+    constexpr const char* CONNECTOR_CLASS_NAME = "QSchematic::Items::Connector";
+    constexpr const char* LABEL_CLASS_NAME = "QSchematic::Items::Label";
+    constexpr const char* WIRE_CLASS_NAME = "QSchematic::Items::Wire";
+    constexpr const char* WIRE_ROUNDED_CORNERS_CLASS_NAME = "QSchematic::Items::WireRoundedCorners";
+
+    /**
+     * What Boost writes about a type.
+     *
+     * @details The tracking levels are the ones Boost uses for the scene: Only the types which are serialized through
+     *          pointers are tracked.
+     */
+    struct ClassInfo
+    {
+        const char* name;       // Exported name, only written for pointers to derived types
+        bool classInfo;         // Whether Boost writes any class information at all
+        int trackingLevel;
+        int version;
+    };
+
+    /**
+     * The class info table, in the order of XmlWriter::Class.
+     */
+    constexpr ClassInfo CLASSES[] = {
+        { nullptr,                          true,   0, 0 },     // Scene
+        { nullptr,                          true,   0, 0 },     // Item
+        { nullptr,                          true,   1, 0 },     // RectItem
+        { NODE_CLASS_NAME,                  true,   1, boost::serialization::version<Items::Node>::value },
+        { CONNECTOR_CLASS_NAME,             true,   1, 0 },
+        { LABEL_CLASS_NAME,                 true,   1, 0 },
+        { WIRE_CLASS_NAME,                  true,   1, 0 },
+        { WIRE_ROUNDED_CORNERS_CLASS_NAME,  true,   1, 0 },
+        { nullptr,                          true,   1, 0 },     // WireNet
+        { nullptr,                          true,   0, 1 },     // ItemPointer
+        { nullptr,                          true,   0, 1 },     // ConnectorPointer
+        { nullptr,                          true,   0, 1 },     // LabelPointer
+        { nullptr,                          true,   0, 1 },     // WirePointer
+        { nullptr,                          true,   0, 1 },     // NetPointer
+        { nullptr,                          true,   0, 0 },     // ItemVector
+        { nullptr,                          true,   0, 0 },     // ConnectorVector
+        { nullptr,                          true,   0, 0 },     // WireVector
+        { nullptr,                          true,   0, 0 },     // NetVector
+        { nullptr,                          true,   0, 0 },     // NetMap
+        { nullptr,                          true,   0, 0 },     // NetPair
+        { nullptr,                          false,  0, 0 },     // IntVector
+    };
+
+    /**
+     * Get the object id stored in an attribute (eg. "_12").
+     */
+    template<typename String>
+    [[nodiscard]]
+    int
+    objectId(const String& value)
+    {
+        return value.mid(1).toInt();
+    }
+
+    [[nodiscard]]
+    bool
+    isWire(const Items::Wire& wire)
+    {
+        const std::type_info& type = typeid(wire);
+        if (type == typeid(Items::Wire))
+            return wire.type() == Items::Item::WireType;
+        if (type == typeid(Items::WireRoundedCorners))
+            return wire.type() == Items::Item::WireRoundedCornersType;
+
+        return false;
+    }
+
+    [[nodiscard]]
+    bool
+    isLabel(const Items::Label& label)
+    {
+        return typeid(label) == typeid(Items::Label) && label.type() == Items::Item::LabelType;
+    }
+
+}
+
+XmlWriter::XmlWriter(QIODevice* device) :
+    _device(device),
+    _writer(device)
+{
+    static_assert(std::size(CLASSES) == static_cast<std::size_t>(Class::Count));
+
+    _writer.setAutoFormatting(true);
+    _writer.setAutoFormattingIndent(-1);
+    _number.reserve(32);
+}
+
+bool
+XmlWriter::write(const Scene& scene)
+{
+    // Custom types are left to Boost
+    if (!canWrite(scene))
+        return writeArchive(scene);
+
+    _classIds.assign(static_cast<std::size_t>(Class::Count), -1);
+    _classInfoWritten.assign(static_cast<std::size_t>(Class::Count), false);
+    _classCount = 0;
+    _objectCount = 0;
+    _netIds.clear();
+
+    // Archive
+    _writer.writeStartDocument(QStringLiteral("1.0"), true);
+    _writer.writeDTD(QStringLiteral("<!DOCTYPE boost_serialization>"));
+    _writer.writeStartElement(QStringLiteral("boost_serialization"));
+    _writer.writeAttribute(QStringLiteral("signature"), QStringLiteral("serialization::archive"));
+    writeAttribute(QStringLiteral("version"), static_cast<int>(boost::archive::BOOST_ARCHIVE_VERSION()));
+    writeStartObject(QStringLiteral("scene"), Class::Scene);
+
+    // Rect
+    {
+        const QRect& rect = scene.sceneRect().toRect();
+        writeNumber(QStringLiteral("scene_x"), rect.x());
+        writeNumber(QStringLiteral("scene_y"), rect.y());
+        writeNumber(QStringLiteral("scene_width"), rect.width());
+        writeNumber(QStringLiteral("scene_height"), rect.height());
+    }
+
+    // Nodes
+    {
+        const auto& nodes = scene.nodes();
+        writeStartCollection(QStringLiteral("nodes"), Class::ItemVector, nodes.count(), 1);
+        for (const auto& node : nodes) {
+            writePointer(QStringLiteral("item"), Class::ItemPointer, Class::Item, Class::Node, node.get(), [this, &node] {
+                writeNode(*node);
+            });
+        }
+        _writer.writeEndElement();
+    }
+
+    // Nets
+    std::vector<std::shared_ptr<Items::WireNet>> nets;
+    {
+        const auto& netList = scene.wire_manager()->nets();
+        nets.reserve(netList.size());
+        for (const auto& net : netList) {
+            // Make sure it's a WireNet
+            if (auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net); wireNet)
+                nets.push_back(std::move(wireNet));
+        }
+
+        writeStartCollection(QStringLiteral("nets"), Class::NetVector, static_cast<int>(nets.size()), 1);
+        for (const auto& net : nets)
+            writeNet(QStringLiteral("item"), net);
+        _writer.writeEndElement();
+    }
+
+    // Wires of the nets, in the order of the std::map used by Boost
+    {
+        std::sort(nets.begin(), nets.end());
+
+        std::vector<const Items::Wire*> wires;
+        writeStartCollection(QStringLiteral("nets_wire"), Class::NetMap, static_cast<int>(nets.size()), 0);
+        for (const auto& net : nets) {
+            writeStartObject(QStringLiteral("item"), Class::NetPair);
+            writeNet(QStringLiteral("first"), net);
+
+            wires.clear();
+            for (const auto& wire : net->wires()) {
+                if (auto wireItem = dynamic_cast<const Items::Wire*>(wire.get()); wireItem)
+                    wires.push_back(wireItem);
+            }
+
+            writeStartCollection(QStringLiteral("second"), Class::WireVector, static_cast<int>(wires.size()), 1);
+            for (const auto* wire : wires) {
+                if (typeid(*wire) == typeid(Items::WireRoundedCorners)) {
+                    writePointer(QStringLiteral("item"), Class::WirePointer, Class::Wire, Class::WireRoundedCorners, wire, [this, wire] {
+                        writeStartObject(QStringLiteral("Wire"), Class::Wire);
+                        writeWire(*wire);
+                        _writer.writeEndElement();
+                    });
+                }
+                else {
+                    writePointer(QStringLiteral("item"), Class::WirePointer, Class::Wire, Class::Wire, wire, [this, wire] {
+                        writeWire(*wire);
+                    });
+                }
+            }
+            _writer.writeEndElement();
+
+            _writer.writeEndElement();
+        }
+        _writer.writeEndElement();
+    }
+
+    _writer.writeEndElement();
+    _writer.writeEndElement();
+    _writer.writeEndDocument();
+
+    return !_writer.hasError();
+}
+
+/**
+ * Checks whether the scene only consists of the built-in types this writer knows about.
+ *
+ * @details Sub-classes might carry additional state, so only the exact types are accepted.
+ */
+bool
+XmlWriter::canWrite(const Scene& scene) const
+{
+    for (const auto& node : scene.nodes()) {
+        if (typeid(*node) != typeid(Items::Node) || node->type() != Items::Item::NodeType)
+            return false;
+
+        for (const auto& connector : node->connectors()) {
+            if (node->isSpecialConnector(connector))
+                continue;
+            if (typeid(*connector) != typeid(Items::Connector) || connector->type() != Items::Item::ConnectorType)
+                return false;
+            if (connector->hasLabel() && !isLabel(*connector->label()))
+                return false;
+        }
+    }
+
+    for (const auto& net : scene.wire_manager()->nets()) {
+        auto wireNet = std::dynamic_pointer_cast<Items::WireNet>(net);
+        if (!wireNet)
+            continue;
+        if (typeid(*wireNet) != typeid(Items::WireNet))
+            return false;
+        if (wireNet->hasLabel() && !isLabel(*wireNet->label()))
+            return false;
+
+        for (const auto& wire : wireNet->wires()) {
+            auto wireItem = dynamic_cast<const Items::Wire*>(wire.get());
+            if (wireItem && !isWire(*wireItem))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+XmlWriter::writeArchive(const Scene& scene)
+{
+    std::ostringstream stream;
+    try {
+        boost::archive::xml_oarchive oa(stream);
+        oa << boost::serialization::make_nvp("scene", scene);
+    }
+    catch (const std::exception& e) {
+        qCritical("XmlWriter::writeArchive(): %s", e.what());
+        return false;
+    }
+
+    const std::string& data = stream.str();
+
+    return _device->write(data.data(), static_cast<qint64>(data.size())) == static_cast<qint64>(data.size());
+}
+
+/**
+ * Assigns the next class id to a type unless it has one already.
+ *
+ * @return Whether the type got registered now.
+ */
+bool
+XmlWriter::registerClass(const Class type)
+{
+    int& id = _classIds[static_cast<std::size_t>(type)];
+    if (id >= 0)
+        return false;
+
+    id = _classCount++;
+
+    return true;
+}
+
+/**
+ * Writes the start element of an object that is not serialized through a pointer.
+ *
+ * @details The class information is written with the first object of a type only.
+ */
+void
+XmlWriter::writeStartObject(const QString& name, const Class type)
+{
+    const auto index = static_cast<std::size_t>(type);
+    const ClassInfo& info = CLASSES[index];
+
+    _writer.writeStartElement(name);
+    registerClass(type);
+    if (!info.classInfo)
+        return;
+
+    if (!_classInfoWritten[index]) {
+        _classInfoWritten[index] = true;
+        writeAttribute(QStringLiteral("class_id"), _classIds[index]);
+        writeAttribute(QStringLiteral("tracking_level"), info.trackingLevel);
+        writeAttribute(QStringLiteral("version"), info.version);
+    }
+    if (info.trackingLevel > 0)
+        writeObjectId(QStringLiteral("object_id"), _objectCount++);
+}
+
+void
+XmlWriter::writeStartCollection(const QString& name, const Class type, const int count, const int itemVersion)
+{
+    writeStartObject(name, type);
+    writeNumber(QStringLiteral("count"), count);
+    writeNumber(QStringLiteral("item_version"), itemVersion);
+}
+
+void
+XmlWriter::writeAttribute(const QString& name, const int value)
+{
+    _number.setNum(value);
+    _writer.writeAttribute(name, _number);
+}
+
+void
+XmlWriter::writeObjectId(const QString& name, const int id)
+{
+    _number.setNum(id);
+    _number.prepend(QLatin1Char('_'));
+    _writer.writeAttribute(name, _number);
+}
+
+/**
+ * Writes a `std::shared_ptr`.
+ *
+ * @details Boost registers the static type of the pointer before the dynamic one (unless it's abstract). The class name
+ *          is only written if the dynamic type got registered by this pointer, Boost knows the static type otherwise.
+ *
+ * @param name The element name.
+ * @param pointer The type of the pointer.
+ * @param staticType The type the pointer points to.
+ * @param type The dynamic type of the object.
+ * @param object The object. May be nullptr.
+ * @param body Writes the content of the object.
+ */
+template<typename Body>
+void
+XmlWriter::writePointer(const QString& name, const Class pointer, const Class staticType, const Class type, const void* object, Body&& body)
+{
+    writeStartObject(name, pointer);
+    if (staticType != Class::Item)
+        registerClass(staticType);
+
+    _writer.writeStartElement(QStringLiteral("px"));
+
+    // Null
+    if (!object) {
+        writeAttribute(QStringLiteral("class_id"), -1);
+        _writer.writeCharacters(QString());
+        _writer.writeEndElement();
+        _writer.writeEndElement();
+        return;
+    }
+
+    // Class
+    const auto index = static_cast<std::size_t>(type);
+    const bool registered = registerClass(type);
+    if (!_classInfoWritten[index]) {
+        _classInfoWritten[index] = true;
+        writeAttribute(QStringLiteral("class_id"), _classIds[index]);
+        if (registered)
+            _writer.writeAttribute(QStringLiteral("class_name"), QLatin1String(CLASSES[index].name));
+        writeAttribute(QStringLiteral("tracking_level"), 1);
+        writeAttribute(QStringLiteral("version"), CLASSES[index].version);
+    }
+    else
+        writeAttribute(QStringLiteral("class_id_reference"), _classIds[index]);
+
+    // Only nets are written twice (nets & nets_wire), the second time as a reference
+    if (const auto it = _netIds.constFind(object); it != _netIds.constEnd()) {
+        writeObjectId(QStringLiteral("object_id_reference"), *it);
+        _writer.writeCharacters(QString());
+    }
+    else {
+        if (type == Class::WireNet)
+            _netIds.insert(object, _objectCount);
+        writeObjectId(QStringLiteral("object_id"), _objectCount++);
+        body();
+    }
+
+    _writer.writeEndElement();
+    _writer.writeEndElement();
+}
+
+void
+XmlWriter::writeItem(const Items::Item& item, const qreal dx, const qreal dy)
+{
+    writeStartObject(QStringLiteral("Item"), Class::Item);
+    writeNumber(QStringLiteral("type"), item.type());
+    writeNumber(QStringLiteral("x"), item.posX() + dx);
+    writeNumber(QStringLiteral("y"), item.posY() + dy);
+    writeNumber(QStringLiteral("rotation"), item.rotation());
+    writeBool(QStringLiteral("movable"), item.isMovable());
+    writeBool(QStringLiteral("visible"), item.isVisible());
+    writeBool(QStringLiteral("snap_to_grid"), item.snapToGrid());
+    writeBool(QStringLiteral("highlight"), item.highlightEnabled());
+    _writer.writeEndElement();
+}
+
+void
+XmlWriter::writeRectItem(const Items::Node& node)
+{
+    writeStartObject(QStringLiteral("RectItem"), Class::RectItem);
+    writeItem(node);
+    writeNumber(QStringLiteral("width"), node.width());
+    writeNumber(QStringLiteral("height"), node.height());
+    writeNumber(QStringLiteral("minimum_width"), node.minimumSize().width());
+    writeNumber(QStringLiteral("minimum_height"), node.minimumSize().height());
+    writeBool(QStringLiteral("allow_mouse_resize"), node.allowMouseResize());
+    writeBool(QStringLiteral("allow_mouse_rotate"), node.allowMouseRotate());
+    _writer.writeEndElement();
+}
+
+void
+XmlWriter::writeNode(const Items::Node& node)
+{
+    // Connectors configuration
+    writeBool(QStringLiteral("connectors_movable"), node.connectorsMovable());
+    writeNumber(QStringLiteral("connectors_snap_policy"), static_cast<int>(node.connectorsSnapPolicy()));
+    writeBool(QStringLiteral("connectors_snap_to_grid"), node.connectorsSnapToGrid());
+
+    // Connectors (the special ones are not serialized)
+    {
+        const auto& connectors = node.connectors();
+        const int count = static_cast<int>(std::count_if(connectors.cbegin(), connectors.cend(), [&node](const auto& connector) {
+            return !node.isSpecialConnector(connector);
+        }));
+
+        writeStartCollection(QStringLiteral("connectors"), Class::ConnectorVector, count, 1);
+        for (const auto& connector : connectors) {
+            if (node.isSpecialConnector(connector))
+                continue;
+
+            writePointer(QStringLiteral("item"), Class::ConnectorPointer, Class::Connector, Class::Connector, connector.get(), [this, &connector] {
+                writeConnector(*connector);
+            });
+        }
+        _writer.writeEndElement();
+    }
+
+    // Root
+    writeRectItem(node);
+    writeNumber(QStringLiteral("width"), node.width());
+    writeNumber(QStringLiteral("height"), node.height());
+    writeBool(QStringLiteral("allow_mouse_resize"), node.allowMouseResize());
+    writeBool(QStringLiteral("allow_mouse_rotate"), node.allowMouseRotate());
+
+    // Symbol
+    const auto& symbol = node.symbol();
+    writeText(QStringLiteral("symbol"), symbol ? symbol->name : QString());
+}
+
+void
+XmlWriter::writeConnector(const Items::Connector& connector)
+{
+    writeItem(connector);
+    writeNumber(QStringLiteral("snap_policy"), static_cast<int>(connector.snapPolicy()));
+    writeBool(QStringLiteral("force_text_direction"), connector.forceTextDirection());
+    writeNumber(QStringLiteral("text_direction"), static_cast<int>(connector.textDirection()));
+    writeLabel(QStringLiteral("label"), connector.hasLabel() ? connector.label().get() : nullptr);
+}
+
+void
+XmlWriter::writeLabel(const QString& name, const Items::Label* label, const qreal dx, const qreal dy)
+{
+    writePointer(name, Class::LabelPointer, Class::Label, Class::Label, label, [this, label, dx, dy] {
+        writeItem(*label, dx, dy);
+        writeText(QStringLiteral("text"), label->text());
+        writeBool(QStringLiteral("hasConnectionPoint"), label->hasConnectionPoint());
+        writeNumber(QStringLiteral("connectionPoint_x"), label->connectionPoint().x());
+        writeNumber(QStringLiteral("connectionPoint_y"), label->connectionPoint().y());
+    });
+}
+
+void
+XmlWriter::writeWire(const Items::Wire& wire)
+{
+    writeItem(wire);
+
+    // Points (truncated to integers like Items::Wire::save() does)
+    const auto& points = wire.points();
+    writeStartCollection(QStringLiteral("points_x"), Class::IntVector, points.count(), 0);
+    for (const auto& point : points)
+        writeNumber(QStringLiteral("item"), static_cast<int>(point.x()));
+    _writer.writeEndElement();
+    writeStartCollection(QStringLiteral("points_y"), Class::IntVector, points.count(), 0);
+    for (const auto& point : points)
+        writeNumber(QStringLiteral("item"), static_cast<int>(point.y()));
+    _writer.writeEndElement();
+}
+
+void
+XmlWriter::writeNet(const QString& name, const std::shared_ptr<Items::WireNet>& net)
+{
+    writePointer(name, Class::NetPointer, Class::WireNet, Class::WireNet, net.get(), [this, &net] {
+        writeText(QStringLiteral("name"), net->name());
+
+        // The coordinates of the label need to be in the scene space
+        const Items::Label* label = net->hasLabel() ? net->label().get() : nullptr;
+        if (label && label->parentItem())
+            writeLabel(QStringLiteral("label"), label, label->parentItem()->pos().x(), label->parentItem()->pos().y());
+        else
+            writeLabel(QStringLiteral("label"), label);
+    });
+}
+
+void
+XmlWriter::writeText(const QString& name, const QString& value)
+{
+    // Boost can't read empty elements
+    _writer.writeTextElement(name, value);
+}
+
+void
+XmlWriter::writeNumber(const QString& name, const qreal value)
+{
+    // Same precision as Boost
+    _number.setNum(value, 'e', 17);
+    _writer.writeTextElement(name, _number);
+}
+
+void
+XmlWriter::writeNumber(const QString& name, const int value)
+{
+    _number.setNum(value);
+    _writer.writeTextElement(name, _number);
+}
+
+void
+XmlWriter::writeBool(const QString& name, const bool value)
+{
+    _writer.writeTextElement(name, value ? QStringLiteral("1") : QStringLiteral("0"));
+}
+
+XmlReader::XmlReader(QIODevice* device) :
+    _device(device)
+{
+}
+
+bool
+XmlReader::read(Scene& scene)
+{
+    _unsupported = false;
+    _classes.clear();
+    _objectId = -1;
+    _nodes.clear();
+    _nets.clear();
+    _netIds.clear();
+    _netWires.clear();
+
+    // Remember where the file starts in case it has to be handed to Boost
+    const qint64 start = _device->pos();
+    _reader.setDevice(_device);
+
+    // Archive
+    if (!_reader.readNextStartElement() || _reader.name() != QLatin1String("boost_serialization")) {
+        _reader.raiseError(QStringLiteral("Not a Boost XML archive."));
+        return false;
+    }
+
+    // Scene
+    if (!_reader.readNextStartElement()) {
+        _reader.raiseError(QStringLiteral("The archive doesn't contain a scene."));
+        return false;
+    }
+    const QString name = _reader.name().toString();
+    readScene();
+
+    // Types this reader doesn't know about are left to Boost
+    if (_unsupported)
+        return readArchive(scene, start, name);
+    if (_reader.hasError())
+        return false;
+
+    // Populate the scene
+    {
+        std::vector<std::pair<std::shared_ptr<Items::WireNet>, std::vector<std::shared_ptr<Items::Wire>>>> nets;
+        nets.reserve(_nets.size());
+        for (const auto& net : _nets)
+            nets.emplace_back(net, _netWires.take(net.get()));
+
+        scene.addContent(_rect, _nodes, nets);
+    }
+
+    // Don't keep the items alive
+    _nodes.clear();
+    _nets.clear();
+    _netIds.clear();
+    _netWires.clear();
+
+    return true;
+}
+
+QString
+XmlReader::errorString() const
+{
+    return _reader.errorString();
+}
+
+bool
+XmlReader::readArchive(Scene& scene, const qint64 start, const QString& name)
+{
+    _nodes.clear();
+    _nets.clear();
+    _netIds.clear();
+    _netWires.clear();
+
+    if (_device->isSequential() || !_device->seek(start)) {
+        _reader.raiseError(QStringLiteral("The file contains custom types but the device can't be read again."));
+        return false;
+    }
+
+    std::istringstream stream(_device->readAll().toStdString());
+    try {
+        boost::archive::xml_iarchive ia(stream);
+        ia >> boost::serialization::make_nvp(name.toUtf8().constData(), scene);
+    }
+    catch (const std::exception& e) {
+        _reader.raiseError(QString::fromUtf8(e.what()));
+        return false;
+    }
+
+    return true;
+}
+
+void
+XmlReader::readScene()
+{
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        // Rect
+        if (name == QLatin1String("scene_x"))
+            x = readInt();
+        else if (name == QLatin1String("scene_y"))
+            y = readInt();
+        else if (name == QLatin1String("scene_width"))
+            width = readInt();
+        else if (name == QLatin1String("scene_height"))
+            height = readInt();
+
+        // Nodes
+        else if (name == QLatin1String("nodes")) {
+            readCollection(
+                [this](const int count) {
+                    _nodes.reserve(count);
+                },
+                [this] {
+                    const Type type = readStartPointer(Type::Item);
+                    if (type == Type::Node)
+                        _nodes.push_back(readNode());
+                    else if (type != Type::Null)
+                        setUnsupported();
+                    readEndPointer();
+                }
+            );
+        }
+
+        // Nets
+        else if (name == QLatin1String("nets")) {
+            readCollection(
+                [this](const int count) {
+                    _nets.reserve(count);
+                    _netIds.reserve(count);
+                },
+                [this] {
+                    const Type type = readStartPointer(Type::WireNet);
+                    if (type == Type::WireNet) {
+                        auto net = std::make_shared<Items::WireNet>();
+                        _netIds.insert(_objectId, net);
+                        readNet(*net);
+                        _nets.push_back(std::move(net));
+                    }
+                    else if (type != Type::Null)
+                        setUnsupported();
+                    readEndPointer();
+                }
+            );
+        }
+
+        // Wires of the nets
+        else if (name == QLatin1String("nets_wire")) {
+            readCollection(
+                [this](const int count) {
+                    _netWires.reserve(count);
+                },
+                [this] {
+                    readNetWires();
+                }
+            );
+        }
+
+        else
+            _reader.skipCurrentElement();
+    }
+
+    _rect = QRect(x, y, width, height);
+}
+
+/**
+ * Reads the items of a collection (eg. a `std::vector`).
+ *
+ * @param reserve Called with the number of items before the items are read.
+ * @param read Reads an item. Called at the start element of each item.
+ */
+template<typename Reserve, typename Read>
+void
+XmlReader::readCollection(Reserve&& reserve, Read&& read)
+{
+    while (_reader.readNextStartElement()) {
+        if (_reader.name() == QLatin1String("count"))
+            reserve(qMax(0, readInt()));
+        else if (_reader.name() == QLatin1String("item"))
+            read();
+        else
+            _reader.skipCurrentElement();
+    }
+}
+
+/**
+ * Reads the start of a `std::shared_ptr`.
+ *
+ * @details On return the reader is at the start element of the object, unless the pointer is null or references an
+ *          object read before (the object id is stored in _objectId in that case). Finish the pointer with
+ *          readEndPointer() once the object was read.
+ *
+ * @param staticType The type the pointer points to. Boost only writes the class name if the object is of a derived type.
+ * @return The dynamic type of the object.
+ */
+XmlReader::Type
+XmlReader::readStartPointer(const Type staticType)
+{
+    if (!_reader.readNextStartElement() || _reader.name() != QLatin1String("px")) {
+        _reader.raiseError(QStringLiteral("Expected a pointer."));
+        return Type::Unknown;
+    }
+    const QXmlStreamAttributes& attributes = _reader.attributes();
+
+    // Class
+    Type type = Type::Unknown;
+    if (attributes.hasAttribute(QLatin1String("class_id"))) {
+        const int classId = attributes.value(QLatin1String("class_id")).toInt();
+        if (classId < 0) {
+            _reader.skipCurrentElement();
+            return Type::Null;
+        }
+
+        type = staticType;
+        if (attributes.hasAttribute(QLatin1String("class_name"))) {
+            const auto className = attributes.value(QLatin1String("class_name"));
+            if (className == QLatin1String(NODE_CLASS_NAME))
+                type = Type::Node;
+            else if (className == QLatin1String(CONNECTOR_CLASS_NAME))
+                type = Type::Connector;
+            else if (className == QLatin1String(LABEL_CLASS_NAME))
+                type = Type::Label;
+            else if (className == QLatin1String(WIRE_CLASS_NAME))
+                type = Type::Wire;
+            else if (className == QLatin1String(WIRE_ROUNDED_CORNERS_CLASS_NAME))
+                type = Type::WireRoundedCorners;
+            else
+                type = Type::Unknown;
+        }
+
+        if (static_cast<std::size_t>(classId) >= _classes.size())
+            _classes.resize(classId + 1, Type::Unknown);
+        _classes[classId] = type;
+    }
+    else {
+        const int classId = attributes.value(QLatin1String("class_id_reference")).toInt();
+        if (classId >= 0 && static_cast<std::size_t>(classId) < _classes.size())
+            type = _classes[classId];
+    }
+    if (type == Type::Unknown || type == Type::Item) {
+        setUnsupported();
+        return Type::Unknown;
+    }
+
+    // Objects are only stored once
+    if (attributes.hasAttribute(QLatin1String("object_id_reference"))) {
+        _objectId = objectId(attributes.value(QLatin1String("object_id_reference")));
+        _reader.skipCurrentElement();
+        return Type::Reference;
+    }
+    _objectId = objectId(attributes.value(QLatin1String("object_id")));
+
+    return type;
+}
+
+/**
+ * Reads the rest of a `std::shared_ptr` after its object was read.
+ */
+void
+XmlReader::readEndPointer()
+{
+    while (_reader.readNextStartElement())
+        _reader.skipCurrentElement();
+}
+
+/**
+ * Stops reading as the file contains things only Boost knows how to read.
+ */
+void
+XmlReader::setUnsupported()
+{
+    _unsupported = true;
+    _reader.raiseError(QStringLiteral("The file contains types which are not built-in."));
+}
+
+void
+XmlReader::readItem(Items::Item& item)
+{
+    qreal x = item.posX();
+    qreal y = item.posY();
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        // The type can't be changed after construction
+        if (name == QLatin1String("type")) {
+            if (readInt() != item.type())
+                setUnsupported();
+        }
+        else if (name == QLatin1String("x"))
+            x = readReal();
+        else if (name == QLatin1String("y"))
+            y = readReal();
+        else if (name == QLatin1String("rotation"))
+            item.setRotation(readReal());
+        else if (name == QLatin1String("movable"))
+            item.setMovable(readBool());
+        else if (name == QLatin1String("visible"))
+            item.setVisible(readBool());
+        else if (name == QLatin1String("snap_to_grid"))
+            item.setSnapToGrid(readBool());
+        else if (name == QLatin1String("highlight"))
+            item.setHighlightEnabled(readBool());
+        else
+            _reader.skipCurrentElement();
+    }
+
+    item.setPos(x, y);
+}
+
+void
+XmlReader::readRectItem(Items::Node& node)
+{
+    qreal width = node.width();
+    qreal height = node.height();
+    QSizeF minimumSize = node.minimumSize();
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        if (name == QLatin1String("Item"))
+            readItem(node);
+        else if (name == QLatin1String("width"))
+            width = readReal();
+        else if (name == QLatin1String("height"))
+            height = readReal();
+        else if (name == QLatin1String("minimum_width"))
+            minimumSize.setWidth(readReal());
+        else if (name == QLatin1String("minimum_height"))
+            minimumSize.setHeight(readReal());
+        else if (name == QLatin1String("allow_mouse_resize"))
+            node.setAllowMouseResize(readBool());
+        else if (name == QLatin1String("allow_mouse_rotate"))
+            node.setAllowMouseRotate(readBool());
+        else
+            _reader.skipCurrentElement();
+    }
+
+    node.setSize(width, height);
+    node.setMinimumSize(minimumSize);
+}
+
+std::shared_ptr<Items::Node>
+XmlReader::readNode()
+{
+    auto node = std::make_shared<Items::Node>();
+    qreal width = 0;
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        // Connectors configuration
+        if (name == QLatin1String("connectors_movable"))
+            node->setConnectorsMovable(readBool());
+        else if (name == QLatin1String("connectors_snap_policy"))
+            node->setConnectorsSnapPolicy(static_cast<Items::Connector::SnapPolicy>(readInt()));
+        else if (name == QLatin1String("connectors_snap_to_grid"))
+            node->setConnectorsSnapToGrid(readBool());
+
+        // Connectors
+        else if (name == QLatin1String("connectors")) {
+            readCollection(
+                [](const int) {
+                },
+                [this, &node] {
+                    const Type type = readStartPointer(Type::Connector);
+                    if (type == Type::Connector)
+                        node->addConnector(readConnector());
+                    else if (type != Type::Null)
+                        setUnsupported();
+                    readEndPointer();
+                }
+            );
+        }
+
+        // Root
+        else if (name == QLatin1String("RectItem"))
+            readRectItem(*node);
+        else if (name == QLatin1String("width"))
+            width = readReal();
+        else if (name == QLatin1String("height"))
+            node->setSize(width, readReal());
+        else if (name == QLatin1String("allow_mouse_resize"))
+            node->setAllowMouseResize(readBool());
+        else if (name == QLatin1String("allow_mouse_rotate"))
+            node->setAllowMouseRotate(readBool());
+
+        // Symbol
+        // The connectors above carry the per-instance state, so only reference the shared definition again
+        else if (name == QLatin1String("symbol"))
+            node->linkSymbol(_reader.readElementText());
+
+        else
+            _reader.skipCurrentElement();
+    }
+
+    return node;
+}
+
+std::shared_ptr<Items::Connector>
+XmlReader::readConnector()
+{
+    auto connector = std::make_shared<Items::Connector>();
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        if (name == QLatin1String("Item"))
+            readItem(*connector);
+        else if (name == QLatin1String("snap_policy"))
+            connector->setSnapPolicy(static_cast<Items::Connector::SnapPolicy>(readInt()));
+        else if (name == QLatin1String("force_text_direction"))
+            connector->setForceTextDirection(readBool());
+        else if (name == QLatin1String("text_direction"))
+            connector->setForcedTextDirection(static_cast<TextDirection>(readInt()));
+
+        // Label
+        else if (name == QLatin1String("label")) {
+            const Type type = readStartPointer(Type::Label);
+            if (type == Type::Label)
+                readLabel(*connector->ensureLabel());
+            else if (type != Type::Null)
+                setUnsupported();
+            readEndPointer();
+        }
+
+        else
+            _reader.skipCurrentElement();
+    }
+
+    return connector;
+}
+
+void
+XmlReader::readLabel(Items::Label& label)
+{
+    QPointF connectionPoint = label.connectionPoint();
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        if (name == QLatin1String("Item"))
+            readItem(label);
+        else if (name == QLatin1String("text"))
+            label.setText(_reader.readElementText());
+        else if (name == QLatin1String("hasConnectionPoint"))
+            label.setHasConnectionPoint(readBool());
+        else if (name == QLatin1String("connectionPoint_x"))
+            connectionPoint.setX(readReal());
+        else if (name == QLatin1String("connectionPoint_y"))
+            connectionPoint.setY(readReal());
+        else
+            _reader.skipCurrentElement();
+    }
+
+    label.setConnectionPoint(connectionPoint);
+}
+
+void
+XmlReader::readWire(Items::Wire& wire)
+{
+    bool hasPoints = false;
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        if (name == QLatin1String("Item"))
+            readItem(wire);
+
+        // Base of the derived wire types
+        else if (name == QLatin1String("Wire"))
+            readWire(wire);
+
+        // Points
+        else if (name == QLatin1String("points_x") || name == QLatin1String("points_y")) {
+            std::vector<int>& coordinates = name == QLatin1String("points_x") ? _pointsX : _pointsY;
+            coordinates.clear();
+            readCollection(
+                [&coordinates](const int count) {
+                    coordinates.reserve(count);
+                },
+                [this, &coordinates] {
+                    coordinates.push_back(readInt());
+                }
+            );
+            hasPoints = true;
+        }
+
+        else
+            _reader.skipCurrentElement();
+    }
+
+    if (hasPoints) {
+        const std::size_t count = std::min(_pointsX.size(), _pointsY.size());
+        QVector<QPointF> points;
+        points.reserve(static_cast<int>(count));
+        for (std::size_t i = 0; i < count; i++)
+            points.append(QPointF(_pointsX[i], _pointsY[i]));
+        wire.set_points(points);
+    }
+
+    // Update
+    wire.update();
+}
+
+void
+XmlReader::readNet(Items::WireNet& net)
+{
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        if (name == QLatin1String("name"))
+            net.set_name(_reader.readElementText());
+
+        // Label
+        else if (name == QLatin1String("label")) {
+            const Type type = readStartPointer(Type::Label);
+            if (type == Type::Label)
+                readLabel(*net.ensureLabel());
+            else if (type != Type::Null)
+                setUnsupported();
+            readEndPointer();
+        }
+
+        else
+            _reader.skipCurrentElement();
+    }
+}
+
+/**
+ * Reads an entry of the map holding the wires of each net.
+ */
+void
+XmlReader::readNetWires()
+{
+    std::shared_ptr<Items::WireNet> net;
+
+    while (_reader.readNextStartElement()) {
+        const auto name = _reader.name();
+
+        // Net, this references one of the nets read before
+        if (name == QLatin1String("first")) {
+            const Type type = readStartPointer(Type::WireNet);
+            if (type == Type::Reference)
+                net = _netIds.value(_objectId);
+            else if (type == Type::WireNet) {
+                // Not part of the scene's nets, Boost ignores its wires as well
+                net = std::make_shared<Items::WireNet>();
+                readNet(*net);
+            }
+            else if (type != Type::Null)
+                setUnsupported();
+            readEndPointer();
+        }
+
+        // Wires
+        else if (name == QLatin1String("second")) {
+            auto& wires = _netWires[net.get()];
+            readCollection(
+                [&wires](const int count) {
+                    wires.reserve(count);
+                },
+                [this, &wires] {
+                    const Type type = readStartPointer(Type::Wire);
+                    std::shared_ptr<Items::Wire> wire;
+                    if (type == Type::Wire)
+                        wire = std::make_shared<Items::Wire>();
+                    else if (type == Type::WireRoundedCorners)
+                        wire = std::make_shared<Items::WireRoundedCorners>();
+                    else if (type != Type::Null)
+                        setUnsupported();
+
+                    if (wire) {
+                        readWire(*wire);
+                        wires.push_back(std::move(wire));
+                    }
+                    readEndPointer();
+                }
+            );
+        }
+
+        else
+            _reader.skipCurrentElement();
+    }
+}
+
+int
+XmlReader::readInt()
+{
+    int value = 0;
+    if (_reader.readNext() == QXmlStreamReader::Characters) {
+        value = _reader.text().toInt();
+        _reader.readNext();
+    }
+    if (!_reader.isEndElement())
+        _reader.raiseError(QStringLiteral("Expected a number."));
+
+    return value;
+}
+
+qreal
+XmlReader::readReal()
+{
+    qreal value = 0;
+    if (_reader.readNext() == QXmlStreamReader::Characters) {
+        value = _reader.text().toDouble();
+        _reader.readNext();
+    }
+    if (!_reader.isEndElement())
+        _reader.raiseError(QStringLiteral("Expected a number."));
+
+    return value;
+}
+
+bool
+XmlReader::readBool()
+{
+    return readInt() != 0;
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <QHash>
+#include <QRect>
+#include <QString>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+class QIODevice;
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    namespace Items
+    {
+        class Item;
+        class Node;
+        class Connector;
+        class Label;
+        class Wire;
+        class WireNet;
+    }
+
+    /**
+     * Streaming XML writer for scenes.
+     *
+     * @details This writes the same document as serializing the scene into a Boost XML archive (as
+     *          `boost::serialization::make_nvp("scene", scene)`), so the files can be read by both XmlReader and Boost.
+     *          It is built on top of QXmlStreamWriter and writes the numbers through a single, reused buffer so no
+     *          temporary strings are created per item. Boost's class & object ids are assigned the same way Boost does.
+     *          Scenes containing items of types not known to this writer (eg. custom node types of a consuming
+     *          application) are handed to the Boost XML archive instead. Such types therefore need to be exported to
+     *          Boost as usual.
+     */
+    class XmlWriter
+    {
+    public:
+        explicit
+        XmlWriter(QIODevice* device);
+
+        /**
+         * Writes a scene.
+         *
+         * @param scene The scene to write.
+         * @return Success indicator.
+         */
+        bool
+        write(const Scene& scene);
+
+    private:
+        /**
+         * The serialized types, in the order of the class info table.
+         */
+        enum class Class
+        {
+            Scene,
+            Item,
+            RectItem,
+            Node,
+            Connector,
+            Label,
+            Wire,
+            WireRoundedCorners,
+            WireNet,
+            ItemPointer,
+            ConnectorPointer,
+            LabelPointer,
+            WirePointer,
+            NetPointer,
+            ItemVector,
+            ConnectorVector,
+            WireVector,
+            NetVector,
+            NetMap,
+            NetPair,
+            IntVector,
+            Count
+        };
+
+        [[nodiscard]] bool canWrite(const Scene& scene) const;
+        bool writeArchive(const Scene& scene);
+        bool registerClass(Class type);
+        void writeStartObject(const QString& name, Class type);
+        void writeStartCollection(const QString& name, Class type, int count, int itemVersion);
+        void writeAttribute(const QString& name, int value);
+        void writeObjectId(const QString& name, int id);
+        template<typename Body>
+        void writePointer(const QString& name, Class pointer, Class staticType, Class type, const void* object, Body&& body);
+        void writeItem(const Items::Item& item, qreal dx = 0, qreal dy = 0);
+        void writeRectItem(const Items::Node& node);
+        void writeNode(const Items::Node& node);
+        void writeConnector(const Items::Connector& connector);
+        void writeLabel(const QString& name, const Items::Label* label, qreal dx = 0, qreal dy = 0);
+        void writeWire(const Items::Wire& wire);
+        void writeNet(const QString& name, const std::shared_ptr<Items::WireNet>& net);
+        void writeText(const QString& name, const QString& value);
+        void writeNumber(const QString& name, qreal value);
+        void writeNumber(const QString& name, int value);
+        void writeBool(const QString& name, bool value);
+
+        QIODevice* _device = nullptr;
+        QXmlStreamWriter _writer;
+        QString _number;
+        std::vector<int> _classIds;                 // Per class, -1 if not registered yet
+        std::vector<bool> _classInfoWritten;        // Per class
+        int _classCount = 0;
+        int _objectCount = 0;
+        QHash<const void*, int> _netIds;            // Object ids of the nets, they are referenced again by nets_wire
+    };
+
+    /**
+     * Streaming XML reader for scenes.
+     *
+     * @details Reads Boost XML archives of a scene (as written by XmlWriter or by serializing the scene into a Boost XML
+     *          archive). Containers are reserved from the element counts stored in the file and numbers are parsed
+     *          in-place without creating temporary strings. All nodes & wires are added to the scene in one go once the
+     *          file was read successfully.
+     *          Files containing items of types not known to this reader (eg. custom node types of a consuming
+     *          application) are handed to the Boost XML archive instead. Such types therefore need to be exported to
+     *          Boost as usual.
+     */
+    class XmlReader
+    {
+    public:
+        explicit
+        XmlReader(QIODevice* device);
+
+        /**
+         * Reads a scene.
+         *
+         * @note The scene should be cleared before calling this.
+         *
+         * @param scene The scene to populate.
+         * @return Success indicator.
+         */
+        bool
+        read(Scene& scene);
+
+        /**
+         * Get a description of the last error.
+         *
+         * @return The error string.
+         */
+        [[nodiscard]]
+        QString
+        errorString() const;
+
+    private:
+        /**
+         * The dynamic type of a pointer.
+         */
+        enum class Type
+        {
+            Unknown,
+            Null,
+            Reference,      // The object was read before
+            Item,
+            Node,
+            Connector,
+            Label,
+            Wire,
+            WireRoundedCorners,
+            WireNet
+        };
+
+        bool readArchive(Scene& scene, qint64 start, const QString& name);
+        void readScene();
+        template<typename Reserve, typename Read>
+        void readCollection(Reserve&& reserve, Read&& read);
+        Type readStartPointer(Type staticType);
+        void readEndPointer();
+        void setUnsupported();
+        void readItem(Items::Item& item);
+        void readRectItem(Items::Node& node);
+        std::shared_ptr<Items::Node> readNode();
+        std::shared_ptr<Items::Connector> readConnector();
+        void readLabel(Items::Label& label);
+        void readWire(Items::Wire& wire);
+        void readNet(Items::WireNet& net);
+        void readNetWires();
+        int readInt();
+        qreal readReal();
+        bool readBool();
+
+        QIODevice* _device = nullptr;
+        QXmlStreamReader _reader;
+        bool _unsupported = false;                                  // The file needs to be read by Boost
+        std::vector<Type> _classes;                                 // Per class id
+        int _objectId = -1;                                         // Of the pointer read last
+        QRect _rect;
+        std::vector<std::shared_ptr<Items::Item>> _nodes;
+        std::vector<std::shared_ptr<Items::WireNet>> _nets;
+        QHash<int, std::shared_ptr<Items::WireNet>> _netIds;        // By object id
+        QHash<const Items::WireNet*, std::vector<std::shared_ptr<Items::Wire>>> _netWires;
+        std::vector<int> _pointsX;                                  // Reused for every wire
+        std::vector<int> _pointsY;                                  // Reused for every wire
+    };
+
+}
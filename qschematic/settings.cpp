@@ -47,3 +47,42 @@ Settings::snapToGrid(const QSizeF& sceneSize) const
 
     return {w, h};
 }
+
+SharedSettings::SharedSettings() :
+    m_source(defaultSource())
+{
+}
+
+SharedSettings::SharedSettings(const Settings& settings) :
+    m_source(std::make_shared<Source>())
+{
+    m_source->settings = std::make_shared<const Settings>(settings);
+}
+
+void
+SharedSettings::set(const Settings& settings)
+{
+    // Never modify the default settings
+    if (m_source == defaultSource())
+        m_source = std::make_shared<Source>();
+
+    m_source->settings = std::make_shared<const Settings>(settings);
+}
+
+const Settings&
+SharedSettings::get() const
+{
+    return *m_source->settings;
+}
+
+const std::shared_ptr<SharedSettings::Source>&
+SharedSettings::defaultSource()
+{
+    static const std::shared_ptr<Source> source = [] {
+        auto s = std::make_shared<Source>();
+        s->settings = std::make_shared<const Settings>();
+        return s;
+    }();
+
+    return source;
+}
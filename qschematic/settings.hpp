@@ -1,6 +1,9 @@
 #pragma once
 
+#include <QtGlobal>
+
 #include <chrono>
+#include <memory>
 
 class QPoint;
 class QPointF;
@@ -21,14 +24,30 @@ namespace QSchematic
         bool debug                  = false;
         int gridSize                = 20;
         int gridPointSize           = 3;
+        int gridPointMinSpacing     = 6;    // Minimum on-screen distance (in pixels) between rendered grid points
         bool showGrid               = true;
+        bool drawBackgroundInScene  = false;    // Draw the background from Scene::drawBackground() instead of adding an item
         int highlightRectPadding    = 10;
         int resizeHandleSize        = 7;
         bool routeStraightAngles    = true;
         bool preserveStraightAngles = true;
         bool antialiasing           = true;
+        bool batchWireRendering     = false;    // Paint wires in one pass from a single wire layer item
         std::chrono::milliseconds popupDelay{ 400 };
 
+        // Level of detail: Scales (device pixels per scene unit) below which details are no longer painted
+        qreal lodMinScaleText       = 0.5;      // Text
+        qreal lodMinScaleSymbols    = 0.3;      // Connector symbols & wire junctions
+        qreal lodMinScaleDetails    = 0.2;      // Rounded corners & handles (nodes are painted as plain rectangles)
+
+        // Cache modes (QGraphicsItem::CacheMode) of the built-in items. Items are repainted from the cache until they
+        // change. Stored as int to keep QGraphicsItem out of this header. 0 is QGraphicsItem::NoCache.
+        int cacheModeNode           = 0;
+        int cacheModeLabel          = 0;
+        int cacheModeConnector      = 0;
+        int cacheModeWire           = 0;
+        int cacheModeBackground     = 0;
+
         // Construction
         Settings() = default;
         Settings(const Settings& other) = default;
@@ -60,4 +79,61 @@ namespace QSchematic
         snapToGrid(const QSizeF& sceneSize) const;
     };
 
+    /**
+     * Shared, immutable settings.
+     *
+     * @details Items hold one of these instead of a copy of the settings. All handles copied from one another share
+     *          the same settings. Replacing the settings through set() is O(1) and is immediately visible through all
+     *          these handles.
+     *          Default constructed handles share the (unmodifiable) default settings. Calling set() on such a handle
+     *          detaches it first.
+     */
+    class SharedSettings
+    {
+    public:
+        SharedSettings();
+
+        explicit
+        SharedSettings(const Settings& settings);
+
+        /**
+         * Replace the settings for all handles sharing them.
+         *
+         * @param settings The new settings.
+         */
+        void
+        set(const Settings& settings);
+
+        [[nodiscard]]
+        const Settings&
+        get() const;
+
+        [[nodiscard]]
+        const Settings*
+        operator->() const
+        {
+            return m_source->settings.get();
+        }
+
+        [[nodiscard]]
+        const Settings&
+        operator*() const
+        {
+            return *m_source->settings;
+        }
+
+    private:
+        struct Source
+        {
+            std::shared_ptr<const Settings> settings;
+        };
+
+        [[nodiscard]]
+        static
+        const std::shared_ptr<Source>&
+        defaultSource();
+
+        std::shared_ptr<Source> m_source;
+    };
+
 }
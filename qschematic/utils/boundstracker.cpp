@@ -0,0 +1,87 @@
+#include "boundstracker.hpp"
+
+using namespace QSchematic::ItemUtils;
+
+void
+BoundsTracker::insert(const QGraphicsItem* item, const QRectF& rect)
+{
+    // Update
+    if (auto it = m_rects.find(item); it != m_rects.end()) {
+        if (it->second == rect)
+            return;
+
+        removeEdges(it->second);
+        it->second = rect;
+        addEdges(rect);
+
+        return;
+    }
+
+    // Insert
+    m_rects.emplace(item, rect);
+    addEdges(rect);
+}
+
+void
+BoundsTracker::remove(const QGraphicsItem* item)
+{
+    auto it = m_rects.find(item);
+    if (it == m_rects.end())
+        return;
+
+    removeEdges(it->second);
+    m_rects.erase(it);
+}
+
+void
+BoundsTracker::clear()
+{
+    m_rects.clear();
+    m_left.clear();
+    m_top.clear();
+    m_right.clear();
+    m_bottom.clear();
+}
+
+QRectF
+BoundsTracker::rect(const QGraphicsItem* item) const
+{
+    if (auto it = m_rects.find(item); it != m_rects.end())
+        return it->second;
+
+    return { };
+}
+
+QRectF
+BoundsTracker::bounds() const
+{
+    if (m_left.empty())
+        return { };
+
+    return QRectF(QPointF(*m_left.cbegin(), *m_top.cbegin()), QPointF(*m_right.crbegin(), *m_bottom.crbegin()));
+}
+
+void
+BoundsTracker::addEdges(const QRectF& rect)
+{
+    if (rect.isNull())
+        return;
+
+    m_left.insert(rect.left());
+    m_top.insert(rect.top());
+    m_right.insert(rect.right());
+    m_bottom.insert(rect.bottom());
+}
+
+void
+BoundsTracker::removeEdges(const QRectF& rect)
+{
+    if (rect.isNull())
+        return;
+
+    // Only erase one instance of each value
+    m_left.erase(m_left.find(rect.left()));
+    m_top.erase(m_top.find(rect.top()));
+    m_right.erase(m_right.find(rect.right()));
+    m_bottom.erase(m_bottom.find(rect.bottom()));
+}
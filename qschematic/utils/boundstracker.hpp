@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QRectF>
+
+#include <set>
+#include <unordered_map>
+
+class QGraphicsItem;
+
+namespace QSchematic::ItemUtils
+{
+
+    /**
+     * Incrementally maintained union of item bounding rects.
+     *
+     * @details The edges of all tracked rects are kept in one ordered multiset per edge. Inserting, updating and
+     *          removing an item is therefore O(log n) while retrieving the combined bounds is O(1).
+     */
+    class BoundsTracker
+    {
+    public:
+        /**
+         * Track an item or update the rect of an already tracked item.
+         *
+         * @param item The item.
+         * @param rect The bounding rect of the item. Null rects don't contribute to the bounds.
+         */
+        void
+        insert(const QGraphicsItem* item, const QRectF& rect);
+
+        /**
+         * Stop tracking an item.
+         *
+         * @param item The item.
+         */
+        void
+        remove(const QGraphicsItem* item);
+
+        /**
+         * Stop tracking all items.
+         */
+        void
+        clear();
+
+        /**
+         * Get the tracked rect of an item.
+         *
+         * @param item The item.
+         * @return The rect. A null rect if the item is not tracked.
+         */
+        [[nodiscard]]
+        QRectF
+        rect(const QGraphicsItem* item) const;
+
+        /**
+         * Get the combined bounds of all tracked items.
+         *
+         * @return The bounds. A null rect if no (non-null) rect is tracked.
+         */
+        [[nodiscard]]
+        QRectF
+        bounds() const;
+
+    private:
+        void
+        addEdges(const QRectF& rect);
+
+        void
+        removeEdges(const QRectF& rect);
+
+        std::unordered_map<const QGraphicsItem*, QRectF> m_rects;
+        std::multiset<qreal> m_left;
+        std::multiset<qreal> m_top;
+        std::multiset<qreal> m_right;
+        std::multiset<qreal> m_bottom;
+    };
+
+}
@@ -0,0 +1,241 @@
+#include "pixmapcache.hpp"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <algorithm>
+
+using namespace QSchematic::ItemUtils;
+
+// Default memory budget
+const qint64 DEFAULT_MAXIMUM_BYTES = 32 * 1024 * 1024;
+
+// Default disk budget
+const qint64 DEFAULT_MAXIMUM_DISK_BYTES = 128 * 1024 * 1024;
+
+// Fraction of the disk budget to trim down to once it's exceeded (so that not every write has to trim)
+const qreal DISK_TRIM_RATIO = 0.75;
+
+// Key of the hot spot in the persisted image's text
+const QString HOTSPOT_TEXT_KEY = QStringLiteral("qschematic-hotspot");
+
+PixmapCache&
+PixmapCache::instance()
+{
+    static PixmapCache cache;
+
+    return cache;
+}
+
+PixmapCache::PixmapCache() :
+    m_maximum_disk_bytes(DEFAULT_MAXIMUM_DISK_BYTES)
+{
+    setMaximumBytes(DEFAULT_MAXIMUM_BYTES);
+
+    // One writer is plenty and keeps the writes ordered
+    m_writer.setMaxThreadCount(1);
+}
+
+void
+PixmapCache::setEnabled(const bool enabled)
+{
+    m_enabled = enabled;
+
+    if (!m_enabled)
+        clear();
+}
+
+bool
+PixmapCache::isEnabled() const
+{
+    return m_enabled;
+}
+
+void
+PixmapCache::setMaximumBytes(const qint64 bytes)
+{
+    m_cache.setMaxCost(static_cast<int>(std::max<qint64>(0, bytes / 1024)));
+}
+
+qint64
+PixmapCache::maximumBytes() const
+{
+    return qint64(m_cache.maxCost()) * 1024;
+}
+
+qint64
+PixmapCache::totalBytes() const
+{
+    return qint64(m_cache.totalCost()) * 1024;
+}
+
+void
+PixmapCache::setDiskCacheDirectory(const QString& path)
+{
+    QMutexLocker lock(&m_disk_mutex);
+
+    m_disk_directory = path;
+    m_disk_bytes = 0;
+
+    if (!m_disk_directory.isEmpty()) {
+        QDir().mkpath(m_disk_directory);
+        trimDisk();
+    }
+}
+
+QString
+PixmapCache::diskCacheDirectory() const
+{
+    return m_disk_directory;
+}
+
+void
+PixmapCache::setMaximumDiskBytes(const qint64 bytes)
+{
+    QMutexLocker lock(&m_disk_mutex);
+
+    m_maximum_disk_bytes = std::max<qint64>(0, bytes);
+
+    if (!m_disk_directory.isEmpty() && m_disk_bytes > m_maximum_disk_bytes)
+        trimDisk();
+}
+
+qint64
+PixmapCache::maximumDiskBytes() const
+{
+    return m_maximum_disk_bytes;
+}
+
+void
+PixmapCache::setSalt(const QByteArray& salt)
+{
+    m_salt = salt;
+}
+
+QByteArray
+PixmapCache::salt() const
+{
+    return m_salt;
+}
+
+bool
+PixmapCache::find(const QByteArray& key, QPixmap& pixmap, QPointF& hotSpot)
+{
+    if (!m_enabled)
+        return false;
+
+    // Memory
+    if (const Entry* entry = m_cache.object(key); entry) {
+        pixmap = entry->pixmap;
+        hotSpot = entry->hotSpot;
+        return true;
+    }
+
+    // Disk
+    if (m_disk_directory.isEmpty())
+        return false;
+
+    QImage image;
+    if (!image.load(filePath(key), "PNG"))
+        return false;
+
+    const auto& hotSpotText = image.text(HOTSPOT_TEXT_KEY).split(QLatin1Char(','));
+    if (hotSpotText.size() != 2)
+        return false;
+
+    pixmap = QPixmap::fromImage(image);
+    hotSpot = QPointF(hotSpotText.at(0).toDouble(), hotSpotText.at(1).toDouble());
+    insertInMemory(key, pixmap, hotSpot);
+
+    return true;
+}
+
+void
+PixmapCache::insert(const QByteArray& key, const QPixmap& pixmap, const QPointF& hotSpot)
+{
+    if (!m_enabled || pixmap.isNull())
+        return;
+
+    insertInMemory(key, pixmap, hotSpot);
+
+    // Disk
+    // Only the conversion to QImage has to happen on this thread. Encoding & writing happens on the writer thread.
+    if (!m_disk_directory.isEmpty()) {
+        QImage image = pixmap.toImage();
+        image.setText(HOTSPOT_TEXT_KEY, QString::number(hotSpot.x()) + QLatin1Char(',') + QString::number(hotSpot.y()));
+
+        const QString directory = m_disk_directory;
+        const QString path = filePath(key);
+        m_writer.start([this, directory, path, image] {
+            writeToDisk(directory, path, image);
+        });
+    }
+}
+
+void
+PixmapCache::clear()
+{
+    m_cache.clear();
+}
+
+QString
+PixmapCache::filePath(const QByteArray& key) const
+{
+    const QByteArray& name = m_salt.isEmpty() ? key : QCryptographicHash::hash(m_salt + key, QCryptographicHash::Sha1);
+
+    return QDir(m_disk_directory).filePath(QString::fromLatin1(name.toHex()) + QStringLiteral(".png"));
+}
+
+void
+PixmapCache::insertInMemory(const QByteArray& key, const QPixmap& pixmap, const QPointF& hotSpot)
+{
+    const qint64 bytes = qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    const int cost = static_cast<int>(std::max<qint64>(1, bytes / 1024));
+
+    m_cache.insert(key, new Entry{ pixmap, hotSpot }, cost);
+}
+
+void
+PixmapCache::writeToDisk(const QString& directory, const QString& path, const QImage& image)
+{
+    // Write to a temporary file first so that find() never reads a partially written file
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit())
+        return;
+
+    QMutexLocker lock(&m_disk_mutex);
+
+    // The directory might have changed in the meantime
+    if (directory != m_disk_directory)
+        return;
+
+    m_disk_bytes += QFileInfo(path).size();
+    if (m_disk_bytes > m_maximum_disk_bytes)
+        trimDisk();
+}
+
+void
+PixmapCache::trimDisk()
+{
+    // Note: m_disk_mutex must be locked
+
+    // Recount as other processes might share the directory
+    const QFileInfoList& files = QDir(m_disk_directory).entryInfoList({ QStringLiteral("*.png") }, QDir::Files, QDir::Time);
+    m_disk_bytes = 0;
+    for (const QFileInfo& file : files)
+        m_disk_bytes += file.size();
+
+    if (m_disk_bytes <= m_maximum_disk_bytes)
+        return;
+
+    // Remove the least recently written files first (the list is sorted newest first)
+    const qint64 target = static_cast<qint64>(m_maximum_disk_bytes * DISK_TRIM_RATIO);
+    for (auto it = files.crbegin(); it != files.crend() && m_disk_bytes > target; ++it) {
+        if (QFile::remove(it->filePath()))
+            m_disk_bytes -= it->size();
+    }
+}
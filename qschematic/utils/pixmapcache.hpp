@@ -0,0 +1,174 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QPixmap>
+#include <QPointF>
+#include <QString>
+#include <QThreadPool>
+
+class QImage;
+
+namespace QSchematic::ItemUtils
+{
+
+    /**
+     * Process-wide cache for rendered items.
+     *
+     * @details This is used by Items::Item::toPixmap() to avoid rendering identical items (eg. library thumbnails and
+     *          drag previews) over and over again. Only items opting in through Items::Item::pixmapCacheable() are
+     *          cached. The cache has a byte budget and evicts the least recently used pixmaps first. Optionally,
+     *          pixmaps are persisted in a directory so they survive restarts. Persisting happens on a worker thread
+     *          and the directory has a byte budget too.
+     *
+     * @note As this deals with QPixmap, it must only be used from the GUI thread.
+     */
+    class PixmapCache
+    {
+    public:
+        /**
+         * Get the process-wide instance.
+         */
+        [[nodiscard]]
+        static
+        PixmapCache&
+        instance();
+
+        void
+        setEnabled(bool enabled);
+
+        [[nodiscard]]
+        bool
+        isEnabled() const;
+
+        /**
+         * Set the memory budget.
+         *
+         * @note Pixmaps get evicted immediately if the cache exceeds the new budget.
+         *
+         * @param bytes The maximum number of bytes held by the pixmaps in memory.
+         */
+        void
+        setMaximumBytes(qint64 bytes);
+
+        [[nodiscard]]
+        qint64
+        maximumBytes() const;
+
+        /**
+         * Get the number of bytes currently held by the pixmaps in memory.
+         */
+        [[nodiscard]]
+        qint64
+        totalBytes() const;
+
+        /**
+         * Set the directory used to persist pixmaps.
+         *
+         * @param path The directory path. An empty path disables persistence.
+         */
+        void
+        setDiskCacheDirectory(const QString& path);
+
+        [[nodiscard]]
+        QString
+        diskCacheDirectory() const;
+
+        /**
+         * Set the disk budget.
+         *
+         * @details If the persisted pixmaps exceed the budget, the least recently written ones get removed until the
+         *          usage is well below the budget again.
+         *
+         * @param bytes The maximum number of bytes held by the persisted pixmaps.
+         */
+        void
+        setMaximumDiskBytes(qint64 bytes);
+
+        [[nodiscard]]
+        qint64
+        maximumDiskBytes() const;
+
+        /**
+         * Set the salt mixed into the names of persisted pixmaps.
+         *
+         * @details Applications should pass their version here so that pixmaps persisted by a version which painted
+         *          items differently are not reused.
+         *
+         * @param salt The salt.
+         */
+        void
+        setSalt(const QByteArray& salt);
+
+        [[nodiscard]]
+        QByteArray
+        salt() const;
+
+        /**
+         * Look up a pixmap.
+         *
+         * @details If the pixmap is not held in memory but was persisted, it gets loaded from disk.
+         *
+         * @param key The key.
+         * @param pixmap The pixmap (if found).
+         * @param hotSpot The hot spot that was stored alongside the pixmap (if found).
+         * @return Whether the pixmap was found.
+         */
+        bool
+        find(const QByteArray& key, QPixmap& pixmap, QPointF& hotSpot);
+
+        /**
+         * Store a pixmap.
+         *
+         * @param key The key.
+         * @param pixmap The pixmap.
+         * @param hotSpot The hot spot.
+         */
+        void
+        insert(const QByteArray& key, const QPixmap& pixmap, const QPointF& hotSpot);
+
+        /**
+         * Clears the in-memory cache.
+         *
+         * @note This does not remove persisted pixmaps.
+         */
+        void
+        clear();
+
+    private:
+        struct Entry
+        {
+            QPixmap pixmap;
+            QPointF hotSpot;
+        };
+
+        PixmapCache();
+
+        [[nodiscard]]
+        QString
+        filePath(const QByteArray& key) const;
+
+        void
+        insertInMemory(const QByteArray& key, const QPixmap& pixmap, const QPointF& hotSpot);
+
+        void
+        writeToDisk(const QString& directory, const QString& path, const QImage& image);
+
+        void
+        trimDisk();
+
+        bool m_enabled = true;
+        QByteArray m_salt;
+        QCache<QByteArray, Entry> m_cache;      // Cost is in KiB
+
+        // Disk bookkeeping. Modified by the writer thread, guarded by the mutex.
+        QMutex m_disk_mutex;
+        QString m_disk_directory;
+        qint64 m_disk_bytes = 0;
+        qint64 m_maximum_disk_bytes;
+
+        QThreadPool m_writer;                   // Encodes & writes the persisted pixmaps. Declared last so it's done before the bookkeeping is destroyed.
+    };
+
+}
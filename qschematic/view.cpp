@@ -1,11 +1,21 @@
+#include <QClipboard>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QMimeData>
 #include <QKeyEvent>
+#include <QPainter>
+#include <QPaintEvent>
 #include <QWheelEvent>
 #include <QScrollBar>
+#include <QTextStream>
 #include <QtMath>
 
+#include <algorithm>
+
 #include "view.hpp"
 #include "scene.hpp"
 #include "settings.hpp"
+#include "items/item.hpp"
 #include "commands/item_remove.hpp"
 
 using namespace QSchematic;
@@ -61,6 +71,20 @@ View::keyPressEvent(QKeyEvent* event)
                     _scene->toggleWirePosture();
                 return;
 
+            case Qt::Key_C:
+                if (_scene) {
+                    if (QMimeData* mimeData = _scene->copySelection())
+                        QGuiApplication::clipboard()->setMimeData(mimeData);
+                }
+                return;
+
+            case Qt::Key_V:
+                if (_scene) {
+                    if (const QMimeData* mimeData = QGuiApplication::clipboard()->mimeData())
+                        _scene->paste(*mimeData, mapToScene(viewport()->mapFromGlobal(QCursor::pos())));
+                }
+                return;
+
             default:
                 break;
         }
@@ -130,6 +154,13 @@ View::mouseMoveEvent(QMouseEvent* event)
             break;
 
         case PanMode:
+            if (!_panPixmap.isNull()) {
+                fastPanBy(event->pos() - _panStart);
+                _panStart = event->pos();
+                event->accept();
+                return;
+            }
+
 #       if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
             horizontalScrollBar()->setValue(horizontalScrollBar()->value() - (event->position().x() - _panStart.x()));
             verticalScrollBar()->setValue(verticalScrollBar()->value() - (event->position().y() - _panStart.y()));
@@ -149,6 +180,8 @@ View::mousePressEvent(QMouseEvent* event)
     if (event->button() == Qt::MiddleButton) {
         setMode(PanMode);
         _panStart = event->pos();
+        if (fast_pan)
+            startFastPan();
         viewport()->setCursor(Qt::ClosedHandCursor);
         event->accept();
         return;
@@ -161,6 +194,7 @@ void
 View::mouseReleaseEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::MiddleButton) {
+        finishFastPan();
         setMode(NormalMode);
         viewport()->setCursor(Qt::ArrowCursor);
         event->accept();
@@ -170,6 +204,154 @@ View::mouseReleaseEvent(QMouseEvent *event)
     QGraphicsView::mouseReleaseEvent(event);
 }
 
+void
+View::paintEvent(QPaintEvent* event)
+{
+    // Frame statistics: Exposed region
+    FrameStats stats;
+    QElapsedTimer timer;
+    const bool showOverlay = _frameStatsEnabled && _settings.debug;
+    if (_frameStatsEnabled) {
+        for (const QRect& rect : event->region())
+            stats.exposedArea += qint64(rect.width()) * rect.height();
+        Items::Item::resetPaintedCount();
+        timer.start();
+    }
+
+    // Paint (fast pan: blit the snapshot)
+    if (!_panPixmap.isNull()) {
+        QPainter painter(viewport());
+        painter.drawPixmap(0, 0, _panPixmap);
+    }
+    else
+        QGraphicsView::paintEvent(event);
+
+    // Frame statistics: Record
+    if (_frameStatsEnabled) {
+        stats.paintDuration = std::chrono::microseconds(timer.nsecsElapsed() / 1000);
+        stats.itemCount = Items::Item::paintedCount();
+
+        _frameStats.push_back(stats);
+        while (_frameStats.size() > std::size_t(std::max(1, frame_stats_capacity)))
+            _frameStats.pop_front();
+    }
+
+    // Frame statistics overlay (viewport coordinates, on top of everything)
+    if (showOverlay) {
+        QPainter painter(viewport());
+        drawFrameStats(painter);
+    }
+}
+
+void
+View::drawFrameStats(QPainter& painter) const
+{
+    const int bucketCount = 20;
+    const std::chrono::microseconds bucketWidth = std::chrono::milliseconds(2);
+    const int barWidth = 6;
+    const int barHeight = 60;
+    const int padding = 6;
+
+    const auto& histogram = frameTimeHistogram(bucketCount, bucketWidth);
+    const int maxCount = std::max(1, *std::max_element(histogram.cbegin(), histogram.cend()));
+
+    // Panel
+    const QRect panel(padding, padding, bucketCount * barWidth + 2 * padding, barHeight + 2 * padding + painter.fontMetrics().height());
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 160));
+    painter.drawRect(panel);
+
+    // Bars
+    painter.setBrush(QColor(Qt::green));
+    for (int i = 0; i < bucketCount; i++) {
+        const int height = histogram[i] * barHeight / maxCount;
+        painter.drawRect(panel.left() + padding + i * barWidth, panel.top() + padding + barHeight - height, barWidth - 1, height);
+    }
+
+    // Last frame
+    if (!_frameStats.empty()) {
+        const FrameStats& last = _frameStats.back();
+        painter.setPen(Qt::white);
+        painter.drawText(
+            QRect(panel.left() + padding, panel.top() + padding + barHeight, panel.width() - 2 * padding, painter.fontMetrics().height()),
+            Qt::AlignLeft | Qt::AlignVCenter,
+            QStringLiteral("%1 ms, %2 items").arg(last.paintDuration.count() / 1000.0, 0, 'f', 2).arg(last.itemCount)
+        );
+    }
+}
+
+void
+View::startFastPan()
+{
+    // Don't bake the frame statistics overlay into the snapshot
+    const bool frameStatsEnabled = _frameStatsEnabled;
+    _frameStatsEnabled = false;
+    _panPixmap = viewport()->grab();
+    _frameStatsEnabled = frameStatsEnabled;
+    _panOffset = { };
+    _panScrollStart = QPoint(horizontalScrollBar()->value(), verticalScrollBar()->value());
+}
+
+void
+View::fastPanBy(QPoint delta)
+{
+    // Honor the scroll bar ranges so that the final scroll position matches the snapshot
+    const QPoint offset(
+        _panScrollStart.x() - qBound(horizontalScrollBar()->minimum(), _panScrollStart.x() - (_panOffset.x() + delta.x()), horizontalScrollBar()->maximum()),
+        _panScrollStart.y() - qBound(verticalScrollBar()->minimum(), _panScrollStart.y() - (_panOffset.y() + delta.y()), verticalScrollBar()->maximum())
+    );
+    delta = offset - _panOffset;
+    if (delta.isNull())
+        return;
+    _panOffset = offset;
+
+    // Move the snapshot
+    QPixmap pixmap(_panPixmap.size());
+    pixmap.setDevicePixelRatio(_panPixmap.devicePixelRatio());
+    QPainter painter(&pixmap);
+    painter.drawPixmap(delta, _panPixmap);
+
+    // Render the uncovered strips
+    if (scene()) {
+        const QSize size = viewport()->size();
+        QVector<QRect> strips;
+        if (delta.x() > 0)
+            strips << QRect(0, 0, delta.x(), size.height());
+        else if (delta.x() < 0)
+            strips << QRect(size.width() + delta.x(), 0, -delta.x(), size.height());
+        if (delta.y() > 0)
+            strips << QRect(0, 0, size.width(), delta.y());
+        else if (delta.y() < 0)
+            strips << QRect(0, size.height() + delta.y(), size.width(), -delta.y());
+
+        painter.setRenderHints(renderHints());
+        for (const QRect& strip : strips) {
+            // The view itself has not scrolled yet: Map the strip back to where its content currently is
+            const QRectF source = mapToScene(strip.translated(-_panOffset)).boundingRect();
+            painter.fillRect(strip, backgroundBrush().style() == Qt::NoBrush ? palette().base() : backgroundBrush());
+            scene()->render(&painter, QRectF(strip), source, Qt::IgnoreAspectRatio);
+        }
+    }
+
+    painter.end();
+    _panPixmap = std::move(pixmap);
+
+    viewport()->update();
+}
+
+void
+View::finishFastPan()
+{
+    if (_panPixmap.isNull())
+        return;
+
+    // Apply the scroll position & repaint everything
+    _panPixmap = { };
+    horizontalScrollBar()->setValue(_panScrollStart.x() - _panOffset.x());
+    verticalScrollBar()->setValue(_panScrollStart.y() - _panOffset.y());
+    viewport()->update();
+}
+
 void
 View::setScene(Scene* scene)
 {
@@ -203,6 +385,10 @@ View::setSettings(const Settings& settings)
 
     // Rendering options
     setRenderHint(QPainter::Antialiasing, _settings.antialiasing);
+
+    // Cache the background if it's drawn by the scene rather than by an item
+    setCacheMode(_settings.drawBackgroundInScene ? QGraphicsView::CacheBackground : QGraphicsView::CacheNone);
+    resetCachedContent();
 }
 
 void
@@ -242,6 +428,59 @@ View::zoomValue() const
     return _scaleFactor;
 }
 
+void
+View::setFrameStatsEnabled(bool enabled)
+{
+    _frameStatsEnabled = enabled;
+    _frameStats.clear();
+
+    viewport()->update();
+}
+
+bool
+View::frameStatsEnabled() const
+{
+    return _frameStatsEnabled;
+}
+
+const std::deque<View::FrameStats>&
+View::frameStats() const
+{
+    return _frameStats;
+}
+
+std::vector<int>
+View::frameTimeHistogram(int bucketCount, std::chrono::microseconds bucketWidth) const
+{
+    // Sanity check
+    if (bucketCount <= 0 || bucketWidth.count() <= 0)
+        return { };
+
+    std::vector<int> histogram(std::size_t(bucketCount), 0);
+    for (const FrameStats& stats : _frameStats) {
+        const auto bucket = std::min<qint64>(stats.paintDuration / bucketWidth, bucketCount - 1);
+        histogram[std::size_t(bucket)]++;
+    }
+
+    return histogram;
+}
+
+bool
+View::writeFrameStatsCsv(QIODevice& device) const
+{
+    if (!device.isWritable())
+        return false;
+
+    QTextStream stream(&device);
+    stream << "frame,paint_duration_us,item_count,exposed_area_px\n";
+    int frame = 0;
+    for (const FrameStats& stats : _frameStats)
+        stream << frame++ << ',' << qint64(stats.paintDuration.count()) << ',' << stats.itemCount << ',' << stats.exposedArea << '\n';
+    stream.flush();
+
+    return stream.status() == QTextStream::Ok;
+}
+
 void
 View::fitInView()
 {
@@ -249,17 +488,8 @@ View::fitInView()
     if (!_scene)
         return;
 
-    // Find the combined bounding rect of all the items
-    QRectF rect;
-    for (const auto& item : _scene->QGraphicsScene::items()) {
-        // Ignore the background item
-        if (_scene->isBackground(item))
-            continue;
-
-        QRectF boundingRect = item->boundingRect();
-        boundingRect.moveTo(item->scenePos());
-        rect = rect.united(boundingRect);
-    }
+    // The combined bounding rect of all the items
+    QRectF rect = _scene->itemsBounds();
 
     // Add some padding
     const auto adj = std::max(0.0, fitall_padding);
@@ -3,6 +3,13 @@
 #include "scene.hpp"
 
 #include <QGraphicsView>
+#include <QPixmap>
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+class QIODevice;
 
 namespace QSchematic
 {
@@ -26,6 +33,18 @@ namespace QSchematic
         qreal zoom_factor_max  = 10.0;
         qreal zoom_factor_step = 0.10;
         qreal fitall_padding   = 20.0;
+        int frame_stats_capacity = 600;    // Number of frames kept by the frame statistics
+        bool fast_pan          = false;    // Pan by moving a snapshot of the viewport. Only newly exposed strips get rendered.
+
+        /**
+         * Statistics of a single painted frame.
+         */
+        struct FrameStats
+        {
+            std::chrono::microseconds paintDuration{ 0 };   // Time spent in paintEvent()
+            int itemCount = 0;                              // Number of items painted
+            qint64 exposedArea = 0;                         // Exposed area in viewport pixels
+        };
 
         /**
          * Constructor.
@@ -65,6 +84,58 @@ namespace QSchematic
         qreal
         zoomValue() const;
 
+        /**
+         * Enable or disable the frame statistics.
+         *
+         * @details When enabled, each repaint of the viewport gets timed and recorded. The last frame_stats_capacity
+         *          frames are kept. If Settings::debug is set, a frame time histogram is drawn on top of the viewport.
+         *          Disabling clears the recorded frames.
+         *
+         * @param enabled Whether to enable the frame statistics.
+         */
+        void
+        setFrameStatsEnabled(bool enabled);
+
+        /**
+         * Get whether frame statistics are enabled.
+         *
+         * @return Whether frame statistics are enabled.
+         */
+        [[nodiscard]]
+        bool
+        frameStatsEnabled() const;
+
+        /**
+         * Get the recorded frames.
+         *
+         * @return The recorded frames, oldest first.
+         */
+        [[nodiscard]]
+        const std::deque<FrameStats>&
+        frameStats() const;
+
+        /**
+         * Get a histogram of the recorded frame times.
+         *
+         * @param bucketCount The number of buckets.
+         * @param bucketWidth The width of each bucket. The last bucket also contains all longer frames.
+         * @return The number of frames per bucket.
+         */
+        [[nodiscard]]
+        std::vector<int>
+        frameTimeHistogram(int bucketCount = 20, std::chrono::microseconds bucketWidth = std::chrono::milliseconds(2)) const;
+
+        /**
+         * Write the recorded frames as CSV.
+         *
+         * @details Writes a header line followed by one line per frame, oldest first.
+         *
+         * @param device The device to write to. Must be open for writing.
+         * @return Success indicator.
+         */
+        bool
+        writeFrameStatsCsv(QIODevice& device) const;
+
     Q_SIGNALS:
         void zoomChanged(qreal factor);
         void modeChanged(Mode newMode);
@@ -94,6 +165,7 @@ namespace QSchematic
         void mouseMoveEvent(QMouseEvent* event) override;
         void mousePressEvent(QMouseEvent* event) override;
         void mouseReleaseEvent(QMouseEvent* event) override;
+        void paintEvent(QPaintEvent* event) override;
 
     private:
         void
@@ -102,10 +174,27 @@ namespace QSchematic
         void
         setMode(Mode newMode);
 
+        void
+        drawFrameStats(QPainter& painter) const;
+
+        void
+        startFastPan();
+
+        void
+        fastPanBy(QPoint delta);
+
+        void
+        finishFastPan();
+
         Scene* _scene = nullptr;
         Settings _settings;
         qreal _scaleFactor = 1.0;
         Mode _mode = Mode::NormalMode;
         QPoint _panStart;
+        QPixmap _panPixmap;     // Viewport snapshot while fast panning
+        QPoint _panOffset;      // Offset of the snapshot relative to the scroll position at the start of the pan
+        QPoint _panScrollStart; // Scroll bar values at the start of the pan
+        bool _frameStatsEnabled = false;
+        std::deque<FrameStats> _frameStats;
     };
 }
@@ -0,0 +1,196 @@
+#include "wire_layer.hpp"
+#include "scene.hpp"
+#include "items/wire.hpp"
+
+#include <QPainter>
+#include <QtMath>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+
+using namespace QSchematic;
+
+// Note: These need to match Items::Wire::paint()
+const QColor WIRE_COLOR    = QColor("#000000");
+const int JUNCTION_RADIUS  = 4;
+
+// Edge length of a cell of the spatial index in scene units
+const qreal CELL_SIZE = 512;
+
+WireLayer::WireLayer(Scene& scene, QGraphicsItem* parent) :
+    QGraphicsRectItem(parent),
+    m_scene(scene)
+{
+    // Line pen
+    m_line_pen.setStyle(Qt::SolidLine);
+    m_line_pen.setCapStyle(Qt::RoundCap);
+    m_line_pen.setWidth(1);
+    m_line_pen.setColor(WIRE_COLOR);
+
+    // Junction pen (a round point is a filled circle)
+    m_junction_pen.setStyle(Qt::SolidLine);
+    m_junction_pen.setCapStyle(Qt::RoundCap);
+    m_junction_pen.setWidth(2 * JUNCTION_RADIUS);
+    m_junction_pen.setColor(WIRE_COLOR);
+
+    // Configuration
+    setPen(Qt::NoPen);
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);  // For QStyleOptionGraphicsItem::exposedRect
+    setFlag(QGraphicsItem::ItemIsMovable, false);
+    setFlag(QGraphicsItem::ItemIsSelectable, false);
+    setFlag(QGraphicsItem::ItemIsFocusable, false);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
+    setFlag(QGraphicsItem::ItemSendsScenePositionChanges, false);
+}
+
+void
+WireLayer::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+
+    update();
+}
+
+QPainterPath
+WireLayer::shape() const
+{
+    return { };
+}
+
+void
+WireLayer::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget)
+
+    // Get the rectangle of interest (er = "exposed rect")
+    const QRectF er = (option ? option->exposedRect : rect());
+    const qreal lod = (option ? option->levelOfDetailFromTransform(painter->worldTransform()) : 1.0);
+    const bool drawJunctions = lod >= m_settings.lodMinScaleSymbols;
+
+    // Find the wires near the exposed rect. If the exposed rect covers more cells than are occupied (eg. when zoomed
+    // out) it's cheaper to go through the occupied cells.
+    m_candidates.clear();
+    const QRect cells = cellRange(er);
+    if (qint64(cells.width()) * cells.height() <= m_cells.size()) {
+        for (int y = cells.top(); y <= cells.bottom(); y++) {
+            for (int x = cells.left(); x <= cells.right(); x++) {
+                if (auto it = m_cells.constFind(cellKey(x, y)); it != m_cells.constEnd())
+                    m_candidates << *it;
+            }
+        }
+    }
+    else {
+        for (const auto& cell : m_cells)
+            m_candidates << cell;
+    }
+
+    // Wires spanning several cells were found more than once
+    std::sort(m_candidates.begin(), m_candidates.end());
+    m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+
+    // Collect the line segments & junctions of the batched wires
+    m_lines.clear();
+    m_junctions.clear();
+    for (const Items::Wire* wire : m_candidates) {
+        if (!wire->isVisible() || !wire->isBatched())
+            continue;
+
+        // Skip wires outside of the exposed rect
+        if (!m_wires.value(wire).bounds.intersects(er))
+            continue;
+
+        const auto& points = wire->points();
+        for (int i = 0; i < points.count(); i++) {
+            if (i > 0)
+                m_lines << QLineF(points.at(i - 1).toPointF(), points.at(i).toPointF());
+            if (drawJunctions && points.at(i).is_junction())
+                m_junctions << points.at(i).toPointF();
+        }
+    }
+
+    // Prepare painter
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, m_settings.antialiasing);
+    painter->setBrush(Qt::NoBrush);
+
+    // Lines
+    painter->setPen(m_line_pen);
+    painter->drawLines(m_lines.constData(), m_lines.size());
+
+    // Junctions
+    painter->setPen(m_junction_pen);
+    painter->drawPoints(m_junctions.constData(), m_junctions.size());
+
+    painter->restore();
+}
+
+void
+WireLayer::insertWire(const Items::Wire& wire, const QRectF& bounds)
+{
+    const QRect cells = bounds.isNull() ? QRect() : cellRange(bounds);
+
+    // Update
+    auto it = m_wires.find(&wire);
+    if (it != m_wires.end()) {
+        it->bounds = bounds;
+        if (it->cells == cells)
+            return;
+
+        removeFromCells(&wire, it->cells);
+        it->cells = cells;
+    }
+    else
+        m_wires.insert(&wire, { bounds, cells });
+
+    // Insert
+    for (int y = cells.top(); y <= cells.bottom(); y++) {
+        for (int x = cells.left(); x <= cells.right(); x++)
+            m_cells[cellKey(x, y)] << &wire;
+    }
+}
+
+void
+WireLayer::removeWire(const Items::Wire& wire)
+{
+    auto it = m_wires.find(&wire);
+    if (it == m_wires.end())
+        return;
+
+    removeFromCells(&wire, it->cells);
+    m_wires.erase(it);
+}
+
+QRect
+WireLayer::cellRange(const QRectF& rect)
+{
+    const int left = qFloor(rect.left() / CELL_SIZE);
+    const int top = qFloor(rect.top() / CELL_SIZE);
+    const int right = qFloor(rect.right() / CELL_SIZE);
+    const int bottom = qFloor(rect.bottom() / CELL_SIZE);
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+quint64
+WireLayer::cellKey(int x, int y)
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+void
+WireLayer::removeFromCells(const Items::Wire* wire, const QRect& cells)
+{
+    for (int y = cells.top(); y <= cells.bottom(); y++) {
+        for (int x = cells.left(); x <= cells.right(); x++) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end())
+                continue;
+
+            it->removeOne(wire);
+            if (it->isEmpty())
+                m_cells.erase(it);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "settings.hpp"
+#include "items/item.hpp"   // For QGraphicsItem::type() overload
+
+#include <QGraphicsRectItem>
+#include <QHash>
+#include <QLineF>
+#include <QPointF>
+#include <QVector>
+
+namespace QSchematic::Items
+{
+    class Wire;
+}
+
+namespace QSchematic
+{
+
+    class Scene;
+
+    /**
+     * Scene item painting all batchable wires in one pass.
+     *
+     * @details This is used if Settings::batchWireRendering is enabled. Instead of every wire painting itself, this
+     *          item collects the line segments and junctions of all wires which are neither selected nor highlighted
+     *          and draws them with a single drawLines() and a single drawPoints() call. The individual wires remain in
+     *          the scene and still handle all the interaction.
+     *          The scene keeps this informed about the bounds of its wires. They are bucketed into a uniform grid so
+     *          that painting only visits the wires near the exposed rect.
+     *
+     * @note Like the background, this is intentionally not a QSchematic::Items::Item.
+     */
+    class WireLayer :
+        public QGraphicsRectItem
+    {
+    public:
+        explicit
+        WireLayer(Scene& scene, QGraphicsItem* parent = nullptr);
+
+        ~WireLayer() override = default;
+
+        void
+        setSettings(const Settings& settings);
+
+        [[nodiscard]]
+        int
+        type() const override
+        {
+            return QSchematic::Items::Item::ItemType::WireLayerType;
+        }
+
+        /**
+         * The wire layer does not participate in hit tests.
+         */
+        [[nodiscard]]
+        QPainterPath
+        shape() const override;
+
+        void
+        paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+        /**
+         * Track a wire or update the bounds of an already tracked wire.
+         *
+         * @param wire The wire.
+         * @param bounds The bounds of the wire in scene coordinates.
+         */
+        void
+        insertWire(const Items::Wire& wire, const QRectF& bounds);
+
+        /**
+         * Stop tracking a wire.
+         *
+         * @param wire The wire.
+         */
+        void
+        removeWire(const Items::Wire& wire);
+
+    private:
+        struct TrackedWire
+        {
+            QRectF bounds;
+            QRect cells;
+        };
+
+        [[nodiscard]]
+        static
+        QRect
+        cellRange(const QRectF& rect);
+
+        [[nodiscard]]
+        static
+        quint64
+        cellKey(int x, int y);
+
+        void
+        removeFromCells(const Items::Wire* wire, const QRect& cells);
+
+        Scene& m_scene;
+        Settings m_settings;
+        QPen m_line_pen;
+        QPen m_junction_pen;
+        QHash<quint64, QVector<const Items::Wire*>> m_cells;     // Spatial index of the wires
+        QHash<const Items::Wire*, TrackedWire> m_wires;
+        QVector<const Items::Wire*> m_candidates;   // Re-used between paint calls
+        QVector<QLineF> m_lines;                    // Re-used between paint calls
+        QVector<QPointF> m_junctions;               // Re-used between paint calls
+    };
+
+}
@@ -4,9 +4,13 @@
 #include "wire.hpp"
 #include "connectable.hpp"
 
+#include <QHash>
+#include <QPair>
 #include <QVector>
 #include <QVector2D>
 
+#include <algorithm>
+
 using namespace wire_system;
 
 manager::manager()
@@ -26,6 +30,11 @@ void manager::add_net(const std::shared_ptr<net> wireNet)
     m_nets.append(wireNet);
 }
 
+void manager::reserve_nets(int count)
+{
+    m_nets.reserve(m_nets.size() + qMax(0, count));
+}
+
 /**
  * Returns a list of all the nets
  */
@@ -120,6 +129,7 @@ bool manager::remove_wire(const std::shared_ptr<wire> wire)
 {
     // Detach from all connectors
     detach_wire_from_all(wire.get());
+    m_batched_wires.removeAll(wire.get());
 
     // Disconnect from connected wires
     for (const auto& otherWire: wires_connected_to(wire)) {
@@ -182,11 +192,11 @@ QVector<std::shared_ptr<wire>> manager::wires_connected_to(const std::shared_ptr
 
             // If they are connected to one of the wire in the list add them to the new list
             for (const auto& wire2 : connectedWires) {
-                if (wire2->connected_wires().contains(otherWire.get())) {
+                if (wire2->connected_wires_ref().contains(otherWire.get())) {
                     newList << otherWire;
                     break;
                 }
-                if (otherWire->connected_wires().contains(wire2.get())) {
+                if (otherWire->connected_wires_ref().contains(wire2.get())) {
                     newList << otherWire;
                     break;
                 }
@@ -257,10 +267,10 @@ void manager::point_moved_by_user(wire& rawWire, int index)
                     continue;
                 }
                 // If is connected
-                if (wire->connected_wires().contains(&rawWire)) {
+                if (wire->connected_wires_ref().contains(&rawWire)) {
                     bool shouldDisconnect = true;
                     // Keep the wires connected if there is another junction
-                    for (const auto& jIndex : rawWire.junctions()) {
+                    for (const auto& jIndex : rawWire.junction_indexes()) {
                         const auto& junction = rawWire.points().at(jIndex);
                         // Ignore the point that moved
                         if (jIndex == index) {
@@ -289,7 +299,7 @@ void manager::point_moved_by_user(wire& rawWire, int index)
                 continue;
             }
             if (wire->point_is_on_wire(rawWire.points().at(index).toPointF())) {
-                if (!rawWire.connected_wires().contains(wire.get())) {
+                if (!rawWire.connected_wires_ref().contains(wire.get())) {
                     connect_wire(wire.get(), &rawWire, index);
                 }
             }
@@ -373,6 +383,7 @@ void manager::point_removed(const wire* wire, int index)
 void manager::detach_wire(const connectable* connector)
 {
     m_connections.remove(connector);
+    m_batched_connectors.removeAll(connector);
 }
 
 std::shared_ptr<wire> manager::wire_with_extremity_at(const QPointF& point)
@@ -417,20 +428,122 @@ int manager::attached_point(const connectable* connector)
 
 void manager::connector_moved(const connectable* connector)
 {
-    if (!m_connections.contains(connector)) {
+    // Defer until the batch ends
+    if (m_batch_depth > 0) {
+        if (m_connections.contains(connector)) {
+            m_batched_connectors.append(connector);
+        }
         return;
     }
+
+    update_attached_point(connector);
+}
+
+/**
+ * Tells the manager that the whole wire moved while batching. end_batch() moves
+ * the wire's attached points back onto their connectors. Does nothing outside
+ * of a batch.
+ */
+void manager::wire_moved(const wire* wire)
+{
+    if (m_batch_depth > 0) {
+        m_batched_wires.append(wire);
+    }
+}
+
+/**
+ * Defers the updates of wires attached to connectors that move until end_batch()
+ * is called. This way each attached point is only moved once, after all the
+ * connectors are at their final position. Batches can be nested.
+ */
+void manager::begin_batch()
+{
+    m_batch_depth++;
+}
+
+/**
+ * Ends a batch started with begin_batch() and updates the attached wires.
+ * Returns the wires which had a point moved.
+ */
+QVector<wire*> manager::end_batch()
+{
+    if (m_batch_depth <= 0 || --m_batch_depth > 0) {
+        return {};
+    }
+
+    QVector<wire*> wires;
+    const auto update = [this, &wires](const connectable* connector) {
+        wire* movedWire = update_attached_point(connector);
+        if (movedWire && !wires.contains(movedWire)) {
+            wires.append(movedWire);
+        }
+    };
+
+    // Connectors first, in the order they moved
+    const auto connectors = std::move(m_batched_connectors);
+    m_batched_connectors.clear();
+    for (const auto& connector : connectors) {
+        update(connector);
+    }
+
+    // Then the points of the moved wires, in the order the wires moved
+    const auto movedWires = std::move(m_batched_wires);
+    m_batched_wires.clear();
+    if (!movedWires.isEmpty()) {
+        QHash<const wire*, QVector<QPair<int, const connectable*>>> attachedPoints;
+        for (auto it = m_connections.cbegin(); it != m_connections.cend(); it++) {
+            attachedPoints[it.value().first].append({ it.value().second, it.key() });
+        }
+        for (const auto& movedWire : movedWires) {
+            auto it = attachedPoints.find(movedWire);
+            if (it == attachedPoints.end()) {
+                continue;
+            }
+            auto points = std::move(it.value());
+            attachedPoints.erase(it);
+            std::stable_sort(points.begin(), points.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+            for (const auto& point : points) {
+                update(point.second);
+            }
+        }
+    }
+
+    return wires;
+}
+
+/**
+ * Returns whether a batch started with begin_batch() is in progress.
+ */
+bool manager::is_batching() const
+{
+    return m_batch_depth > 0;
+}
+
+/**
+ * Moves the wire point attached to the connector to the connector's position.
+ * Returns the wire if the point was moved.
+ */
+wire* manager::update_attached_point(const connectable* connector)
+{
+    if (!m_connections.contains(connector)) {
+        return nullptr;
+    }
     const auto wirePoint = m_connections.value(connector);
 
     if (wirePoint.second < -1 || wirePoint.first->points_count() <= wirePoint.second) {
-        return;
+        return nullptr;
     }
 
     QPointF oldPos = wirePoint.first->points().at(wirePoint.second).toPointF();
     QVector2D moveBy = QVector2D(connector->position() - oldPos);
-    if (!moveBy.isNull()) {
-        wirePoint.first->move_point_by(wirePoint.second, moveBy);
+    if (moveBy.isNull()) {
+        return nullptr;
     }
+    wirePoint.first->move_point_by(wirePoint.second, moveBy);
+
+    return wirePoint.first;
 }
 
 /**
@@ -454,7 +567,7 @@ void manager::set_settings(const Settings& settings)
     m_settings = settings;
 }
 
-Settings manager::settings() const
+const Settings& manager::settings() const
 {
     return m_settings;
 }
@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QList>
 #include <QMap>
+#include <QVector>
 
 #include <memory>
 #include <optional>
@@ -40,6 +41,7 @@ namespace wire_system
         manager& operator=(manager&& rhs) = delete;
 
         void add_net(const std::shared_ptr<net> wireNet);
+        void reserve_nets(int count);       // Number of nets about to be added
         [[nodiscard]] QList<std::shared_ptr<net>> nets() const;
         [[nodiscard]] QList<std::shared_ptr<wire>> wires() const;
         void generate_junctions();
@@ -59,11 +61,15 @@ namespace wire_system
         void point_inserted(const wire* wire, int index);
         [[nodiscard]] bool point_is_attached(wire_system::wire* wire, int index) const;
         void set_settings(const Settings& settings);
-        [[nodiscard]] Settings settings() const;
+        [[nodiscard]] const Settings& settings() const;
         void point_removed(const wire* wire, int index);
         void point_moved_by_user(wire& rawWire, int index);
         void set_net_factory(std::function<std::shared_ptr<net>()> func);
         void connector_moved(const connectable* connector);
+        void wire_moved(const wire* wire);
+        void begin_batch();
+        QVector<wire*> end_batch();
+        [[nodiscard]] bool is_batching() const;
 
     Q_SIGNALS:
         void wire_point_moved(wire& wire, int index);
@@ -72,11 +78,15 @@ namespace wire_system
         [[nodiscard]] static bool merge_nets(std::shared_ptr<wire_system::net>& net, std::shared_ptr<wire_system::net>& otherNet);
 
         void detach_wire_from_all(const wire* wire);
+        wire* update_attached_point(const connectable* connector);
         [[nodiscard]] std::shared_ptr<net> create_net();
 
         QList<std::shared_ptr<net>> m_nets;
         Settings m_settings;
         QMap<const connectable*, QPair<wire*, int>> m_connections;
+        int m_batch_depth = 0;
+        QVector<const connectable*> m_batched_connectors;     // In the order they moved
+        QVector<const wire*> m_batched_wires;                 // In the order they moved
         std::optional<std::function<std::shared_ptr<net>()>> m_net_factory;
     };
 
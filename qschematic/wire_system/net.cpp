@@ -44,7 +44,7 @@ bool net::addWire(const std::shared_ptr<wire>& wire)
     }
 
     // Update the junctions of the wires that are already in the net
-    for (const auto& otherWire : wire->connected_wires()) {
+    for (const auto& otherWire : wire->connected_wires_ref()) {
         for (int index = 0; index < otherWire->points_count(); index++) {
             // Ignore if it's not the first/last point
             if (index != 0 && index != otherWire->points_count() - 1) {
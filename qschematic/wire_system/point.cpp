@@ -1,41 +1,35 @@
 #include "point.hpp"
 
+#include <type_traits>
+
 using namespace wire_system;
 
+static_assert(std::is_trivially_copyable_v<point>);
+static_assert(sizeof(point) <= sizeof(QPointF) + sizeof(qreal));
+
 point::point() :
     QPointF()
 {
-    m_is_junction = false;
-}
-
-point::point(const point& other) :
-    QPointF(other)
-{
-    m_is_junction = other.m_is_junction;
 }
 
 point::point(const QPoint& point) :
     QPointF(point)
 {
-    m_is_junction = false;
 }
 
 point::point(const QPointF& point) :
     QPointF(point)
 {
-    m_is_junction = false;
 }
 
 point::point(int x, int y) :
     QPointF(x, y)
 {
-    m_is_junction = false;
 }
 
 point::point(qreal x, qreal y) :
     QPointF(x, y)
 {
-    m_is_junction = false;
 }
 
 QPointF point::toPointF() const
@@ -5,6 +5,13 @@
 namespace wire_system
 {
 
+    /**
+     * A point of a wire.
+     *
+     * @details Wires of large schematics hold millions of these. This is therefore kept as a plain value type (no
+     *          vtable, trivially copyable) so that it's as small as the coordinates & the junction flag and so that
+     *          containers can relocate it with memmove.
+     */
     class point :
         private QPointF
     {
@@ -19,25 +26,28 @@ namespace wire_system
         using QPointF::toPoint;
 
         point();
-        point(const point& other);
+        point(const point& other) = default;
         point(point&&) = default;
         point(const QPoint& point);
         point(const QPointF& point);
         point(int x, int y);
         point(qreal x, qreal y);
-        virtual ~point() = default;
+        ~point() = default;
         point& operator=(const point&) = default;
+        point& operator=(point&&) = default;
 
         QPointF toPointF() const;
         void set_is_junction(bool isJunction);
         [[nodiscard]] bool is_junction() const;
 
     private:
-        bool m_is_junction;
+        bool m_is_junction = false;
     };
 
 }
 
+Q_DECLARE_TYPEINFO(wire_system::point, Q_MOVABLE_TYPE);
+
 bool operator==(const wire_system::point& a, const wire_system::point& b);
 bool operator==(const wire_system::point& a, const QPoint& b);
 bool operator==(const wire_system::point& a, const QPointF& b);
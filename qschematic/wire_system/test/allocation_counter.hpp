@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts heap allocations made through operator new while a Counter is alive.
+ *
+ * @note The counting operator new is defined in tests/allocations.cpp.
+ */
+namespace allocation_counter
+{
+    inline int count = 0;
+    inline std::size_t bytes = 0;
+    inline bool enabled = false;
+
+    struct Counter
+    {
+        Counter()
+        {
+            count = 0;
+            bytes = 0;
+            enabled = true;
+        }
+
+        ~Counter()
+        {
+            enabled = false;
+        }
+
+        int
+        stop()
+        {
+            enabled = false;
+            return count;
+        }
+
+        [[nodiscard]]
+        std::size_t
+        allocatedBytes() const
+        {
+            return bytes;
+        }
+    };
+}
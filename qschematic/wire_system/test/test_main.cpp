@@ -1,2 +1,16 @@
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_IMPLEMENT
 #include "3rdparty/doctest.h"
+
+#include <QApplication>
+
+int
+main(int argc, char** argv)
+{
+    // The item tests need an application instance (fonts, pixmaps). Don't require a display for that.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    doctest::Context context(argc, argv);
+    return context.run();
+}
@@ -0,0 +1,100 @@
+#include "../3rdparty/doctest.h"
+#include "../allocation_counter.hpp"
+#include "../../line.hpp"
+#include "../../manager.hpp"
+#include "../../wire.hpp"
+
+#include <cstdlib>
+#include <new>
+
+using allocation_counter::Counter;
+
+void*
+operator new(std::size_t size)
+{
+    if (allocation_counter::enabled) {
+        allocation_counter::count++;
+        allocation_counter::bytes += size;
+    }
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST_SUITE("Allocations")
+{
+    TEST_CASE("Geometry accessors don't allocate")
+    {
+        wire_system::manager manager;
+
+        // Create the first wire
+        auto wire1 = std::make_shared<wire_system::wire>();
+        wire1->append_point({0, 10});
+        wire1->append_point({10, 10});
+        wire1->append_point({10, 20});
+        manager.add_wire(wire1);
+
+        // Create a second wire that ends on the first one
+        auto wire2 = std::make_shared<wire_system::wire>();
+        wire2->append_point({5, 0});
+        wire2->append_point({5, 10});
+        manager.add_wire(wire2);
+
+        manager.generate_junctions();
+        REQUIRE(wire1->connected_wires().contains(wire2.get()));
+
+        Counter counter;
+
+        int junctionCount = 0;
+        for (const auto& wire : wire1->connected_wires_ref()) {
+            for (int index : wire->junction_indexes()) {
+                if (wire->points().at(index).is_junction())
+                    junctionCount++;
+            }
+        }
+
+        int segmentCount = 0;
+        for (int i = 0; i < wire1->line_segments_count(); i++) {
+            if (!wire1->line_segment(i).is_null())
+                segmentCount++;
+        }
+
+        const bool onWire = wire1->point_is_on_wire(QPointF(10, 15));
+
+        const int allocations = counter.stop();
+        CHECK_EQ(allocations, 0);
+        CHECK_EQ(junctionCount, 1);
+        CHECK_EQ(segmentCount, 2);
+        CHECK(onWire);
+    }
+
+    TEST_CASE("Segment view matches line_segments()")
+    {
+        wire_system::wire wire;
+        wire.append_point({0, 0});
+        wire.append_point({10, 0});
+        wire.append_point({10, 10});
+        wire.append_point({20, 10});
+
+        const auto segments = wire.line_segments();
+        REQUIRE_EQ(wire.line_segments_count(), segments.count());
+        for (int i = 0; i < segments.count(); i++) {
+            CHECK_EQ(wire.line_segment(i).p1(), segments.at(i).p1());
+            CHECK_EQ(wire.line_segment(i).p2(), segments.at(i).p2());
+        }
+    }
+}
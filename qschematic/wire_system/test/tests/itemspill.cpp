@@ -0,0 +1,43 @@
+#include "../3rdparty/doctest.h"
+#include "../../../commands/item_spill.hpp"
+#include "../../../items/connector.hpp"
+#include "../../../items/node.hpp"
+
+#include <memory>
+
+using namespace QSchematic;
+
+TEST_SUITE("ItemSpill")
+{
+    TEST_CASE("Pinned items are not spilled")
+    {
+        auto node = std::make_shared<Items::Node>();
+        auto connector = std::make_shared<Items::Connector>();
+        node->addConnector(connector);
+        const Items::Connector* rawConnector = connector.get();
+        connector.reset();
+
+        Commands::ItemSpill spill(node);
+        node.reset();
+
+        {
+            // A pin on a child keeps the parent in memory too
+            Commands::ItemPin pin(rawConnector);
+            CHECK_FALSE(spill.spill());
+            CHECK_FALSE(spill.isSpilled());
+
+            // Copies pin as well
+            Commands::ItemPin copy(pin);
+            pin = Commands::ItemPin();
+            CHECK_FALSE(spill.spill());
+        }
+
+        // Unpinned
+        CHECK(spill.spill());
+        CHECK(spill.isSpilled());
+
+        const auto restored = std::dynamic_pointer_cast<Items::Node>(spill.item());
+        REQUIRE(restored);
+        CHECK_EQ(restored->connectors().count(), 1);
+    }
+}
@@ -0,0 +1,237 @@
+#include "../3rdparty/doctest.h"
+#include "../allocation_counter.hpp"
+#include "../../../items/connector.hpp"
+#include "../../../items/label.hpp"
+#include "../../../items/wirenet.hpp"
+#include "../../../utils/pixmapcache.hpp"
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <memory>
+#include <vector>
+
+using namespace QSchematic;
+
+namespace
+{
+    struct PaintableLabel :
+        Items::Label
+    {
+        using Items::Label::paint;
+    };
+
+    QImage
+    render(Items::Label& label, qreal scale = 1.0)
+    {
+        QPointF hotSpot;
+
+        return label.toPixmap(hotSpot, scale).toImage();
+    }
+}
+
+TEST_SUITE("Label")
+{
+    TEST_CASE("Static text follows text and scale changes")
+    {
+        // Render every time
+        auto& cache = ItemUtils::PixmapCache::instance();
+        cache.setEnabled(false);
+
+        Items::Label label;
+        label.setText("R1");
+        const QImage first = render(label);
+        REQUIRE_FALSE(first.isNull());
+
+        // Painting again gives the same result
+        CHECK_EQ(render(label), first);
+
+        // Changing the text lays it out again
+        label.setText("R100");
+        const QImage changed = render(label);
+        CHECK_NE(changed, first);
+
+        // Going back gives the same result as before
+        label.setText("R1");
+        CHECK_EQ(render(label), first);
+
+        // A different scale gives the same text at that scale
+        const QImage scaled = render(label, 2.0);
+        CHECK_EQ(scaled.size(), first.size() * 2);
+        CHECK_EQ(render(label), first);
+
+        cache.setEnabled(true);
+    }
+
+    TEST_CASE("Zooming reuses the prepared layout")
+    {
+        PaintableLabel label;
+        label.setText("Zoom test label");
+
+        QImage image(label.boundingRect().size().toSize() * 4, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        QStyleOptionGraphicsItem option;
+
+        // Bytes allocated by painting the label at a scale
+        const auto paint = [&](qreal scale) {
+            painter.resetTransform();
+            painter.scale(scale, scale);
+            painter.translate(-label.boundingRect().topLeft());
+
+            allocation_counter::Counter counter;
+            label.paint(&painter, &option, nullptr);
+            counter.stop();
+
+            return counter.allocatedBytes();
+        };
+
+        // Warm up the glyph caches of all the scales used below
+        paint(1.5);
+        paint(1.75);
+        paint(3.0);
+
+        // Both scales round up to 2: Only the first one lays out the text
+        const std::size_t prepared = paint(1.5);
+        const std::size_t reused = paint(1.75);
+
+        MESSAGE("Bytes allocated by Label::paint(): " << prepared << " laying out, " << reused << " reusing the layout");
+        CHECK_LT(reused, prepared);
+    }
+
+    TEST_CASE("Paint time")
+    {
+        PaintableLabel label;
+        label.setText("Resistor R1");
+
+        QImage image(label.boundingRect().size().toSize() * 2, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.translate(-label.boundingRect().topLeft());
+        QStyleOptionGraphicsItem option;
+
+        const int iterations = 10000;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; i++)
+            label.paint(&painter, &option, nullptr);
+        MESSAGE("Label::paint(): " << timer.nsecsElapsed() / iterations << " ns");
+    }
+
+    TEST_CASE("Connectors and nets create their label on first use")
+    {
+        Items::Connector connector;
+        CHECK_FALSE(connector.hasLabel());
+        CHECK(connector.text().isEmpty());
+        CHECK_FALSE(connector.hasLabel());      // Reading the text doesn't create the label
+        CHECK_FALSE(connector.label());
+        CHECK_FALSE(connector.hasLabel());      // Neither does getting the label
+
+        connector.setText("A");
+        CHECK(connector.hasLabel());
+        CHECK_EQ(connector.label(), connector.ensureLabel());
+
+        Items::Connector empty;
+        REQUIRE(empty.ensureLabel());
+        CHECK(empty.hasLabel());
+
+        Items::WireNet net;
+        CHECK_FALSE(net.hasLabel());
+        CHECK_FALSE(net.label());
+
+        net.set_name("GND");
+        CHECK(net.hasLabel());
+        CHECK_EQ(net.label(), net.ensureLabel());
+    }
+
+    TEST_CASE("Connectors without text don't allocate a label")
+    {
+        // Warm up so that one-time initializations aren't attributed to the first connector
+        Items::Connector(Items::Item::ConnectorType, QPoint(), "warm up");
+
+        std::size_t withoutLabel = 0;
+        {
+            allocation_counter::Counter counter;
+            Items::Connector connector;
+            counter.stop();
+            withoutLabel = counter.allocatedBytes();
+        }
+
+        std::size_t withLabel = 0;
+        {
+            allocation_counter::Counter counter;
+            Items::Connector connector(Items::Item::ConnectorType, QPoint(), "A");
+            counter.stop();
+            withLabel = counter.allocatedBytes();
+        }
+
+        MESSAGE("Bytes allocated per connector: " << withoutLabel << " without label, " << withLabel << " with label");
+        CHECK_LT(withoutLabel, withLabel);
+    }
+
+    // This holds up to 1M connectors & labels at once, so it needs a few GB of memory. Run it with --no-skip.
+    TEST_CASE("Memory of 1M connectors" * doctest::skip())
+    {
+        constexpr int count = 1'000'000;
+
+        struct Result
+        {
+            std::size_t bytes = 0;
+            qint64 ms = 0;
+        };
+
+        // Bytes allocated by creating the connectors, all of them are alive at the end
+        const auto measure = [](const QString& text) {
+            std::vector<std::shared_ptr<Items::Connector>> connectors;
+            connectors.reserve(count);
+
+            QElapsedTimer timer;
+            timer.start();
+            allocation_counter::Counter counter;
+            for (int i = 0; i < count; i++)
+                connectors.push_back(std::make_shared<Items::Connector>(Items::Item::ConnectorType, QPoint(i % 1000, i / 1000), text));
+            counter.stop();
+            CHECK_EQ(connectors.back()->hasLabel(), !text.isEmpty());
+
+            return Result{ counter.allocatedBytes(), timer.elapsed() };
+        };
+
+        const Result withoutLabel = measure(QString());
+        const Result withLabel = measure(QStringLiteral("A"));
+
+        MESSAGE(count << " connectors without label: " << withoutLabel.bytes / (1024 * 1024) << " MiB (" << withoutLabel.bytes / count << " bytes each), " << withoutLabel.ms << " ms");
+        MESSAGE(count << " connectors with label: " << withLabel.bytes / (1024 * 1024) << " MiB (" << withLabel.bytes / count << " bytes each), " << withLabel.ms << " ms");
+        CHECK_LT(withoutLabel.bytes, withLabel.bytes);
+    }
+
+    TEST_CASE("Identical labels share the text layout")
+    {
+        const QString text = QStringLiteral("Shared layout test label");
+
+        // The first label lays out the text
+        Items::Label first;
+        std::size_t firstBytes = 0;
+        {
+            allocation_counter::Counter counter;
+            first.setText(text);
+            counter.stop();
+            firstBytes = counter.allocatedBytes();
+        }
+
+        // The second one gets it from the cache
+        Items::Label second;
+        std::size_t secondBytes = 0;
+        {
+            allocation_counter::Counter counter;
+            second.setText(text);
+            counter.stop();
+            secondBytes = counter.allocatedBytes();
+        }
+
+        MESSAGE("Bytes allocated by setText(): " << firstBytes << " first, " << secondBytes << " shared");
+        CHECK_LT(secondBytes, firstBytes);
+        CHECK_EQ(second.textRect(), first.textRect());
+    }
+}
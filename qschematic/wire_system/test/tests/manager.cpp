@@ -3,6 +3,8 @@
 #include "../../manager.hpp"
 #include "../../wire.hpp"
 
+#include <QVector2D>
+
 TEST_SUITE("Manager")
 {
     TEST_CASE ("add_wire(): Wires can be added to the manager")
@@ -206,6 +208,42 @@ TEST_SUITE("Manager")
         }
     }
 
+    TEST_CASE ("end_batch(): Moved wires are pulled back onto their connectors")
+    {
+        wire_system::manager manager;
+
+        Settings settings;
+        settings.gridSize = 1;
+        settings.preserveStraightAngles = false;
+        manager.set_settings(settings);
+
+        // Create a wire attached to a connector
+        auto wire = std::make_shared<wire_system::wire>();
+        wire->append_point({0, 10});
+        wire->append_point({10, 10});
+        manager.add_wire(wire);
+
+        connector conn;
+        conn.pos = QPointF(10, 10);
+        manager.attach_wire_to_connector(wire.get(), &conn);
+
+        // Move the whole wire while batching
+        manager.begin_batch();
+        REQUIRE(manager.is_batching());
+        wire->move(QVector2D(0, 5));
+        manager.wire_moved(wire.get());
+
+        // Nothing happens until the batch ends
+        REQUIRE_EQ(wire->points().at(1).toPointF(), QPointF(10, 15));
+
+        const auto movedWires = manager.end_batch();
+        REQUIRE_FALSE(manager.is_batching());
+        REQUIRE_EQ(movedWires.count(), 1);
+        REQUIRE_EQ(movedWires.first(), wire.get());
+        REQUIRE_EQ(wire->points().at(0).toPointF(), QPointF(0, 15));
+        REQUIRE_EQ(wire->points().at(1).toPointF(), QPointF(10, 10));
+    }
+
     TEST_CASE("Connections are updated when a points is inserted or removed")
     {
         wire_system::manager manager;
@@ -0,0 +1,51 @@
+#include "../3rdparty/doctest.h"
+#include "../../../items/node.hpp"
+#include "../../../utils/pixmapcache.hpp"
+
+using namespace QSchematic;
+
+TEST_SUITE("PixmapCache")
+{
+    TEST_CASE("Position and Z value don't affect the cache key")
+    {
+        auto& cache = ItemUtils::PixmapCache::instance();
+        cache.clear();
+
+        QPointF hotSpot;
+
+        Items::Node node1;
+        node1.setSize(80, 40);
+        REQUIRE_FALSE(node1.toPixmap(hotSpot).isNull());
+        const qint64 bytes = cache.totalBytes();
+        REQUIRE_GT(bytes, 0);
+
+        // Same rendering, different place
+        Items::Node node2;
+        node2.setSize(80, 40);
+        node2.setPos(100, 200);
+        node2.setZValue(5);
+        REQUIRE_FALSE(node2.toPixmap(hotSpot).isNull());
+        CHECK_EQ(cache.totalBytes(), bytes);
+
+        // Different rendering
+        Items::Node node3;
+        node3.setSize(160, 40);
+        REQUIRE_FALSE(node3.toPixmap(hotSpot).isNull());
+        CHECK_GT(cache.totalBytes(), bytes);
+
+        cache.clear();
+    }
+
+    TEST_CASE("Items of custom types are not cached unless they opt in")
+    {
+        auto& cache = ItemUtils::PixmapCache::instance();
+        cache.clear();
+
+        QPointF hotSpot;
+
+        Items::Node node(Items::Item::QSchematicItemUserType + 1);
+        node.setSize(80, 40);
+        REQUIRE_FALSE(node.toPixmap(hotSpot).isNull());
+        CHECK_EQ(cache.totalBytes(), 0);
+    }
+}
@@ -0,0 +1,102 @@
+#include "../3rdparty/doctest.h"
+#include "../allocation_counter.hpp"
+#include "../../point.hpp"
+#include "../../wire.hpp"
+
+#include <QElapsedTimer>
+#include <QVector>
+
+TEST_SUITE("Point")
+{
+    TEST_CASE("Copies keep the junction flag")
+    {
+        wire_system::point p(10, 20);
+        p.set_is_junction(true);
+
+        wire_system::point copy(p);
+        CHECK_EQ(copy.toPointF(), QPointF(10, 20));
+        CHECK(copy.is_junction());
+
+        wire_system::point assigned;
+        CHECK_FALSE(assigned.is_junction());
+        assigned = p;
+        CHECK(assigned.is_junction());
+    }
+
+    TEST_CASE("Relocation in containers keeps the junction flag")
+    {
+        QVector<wire_system::point> points;
+        for (int i = 0; i < 100; i++) {
+            wire_system::point p(i, -i);
+            p.set_is_junction(i % 3 == 0);
+            points.append(p);
+        }
+
+        points.prepend(wire_system::point(-1, 1));
+        points.remove(50);
+
+        REQUIRE_EQ(points.count(), 100);
+        CHECK_EQ(points.at(0).toPointF(), QPointF(-1, 1));
+        CHECK_FALSE(points.at(0).is_junction());
+        for (int i = 1; i < points.count(); i++) {
+            const int value = i < 50 ? i - 1 : i;
+            CHECK_EQ(points.at(i).toPointF(), QPointF(value, -value));
+            CHECK_EQ(points.at(i).is_junction(), value % 3 == 0);
+        }
+    }
+
+    TEST_CASE("Wire points are not copied")
+    {
+        wire_system::wire wire;
+        wire.append_point(QPointF(0, 0));
+        wire.append_point(QPointF(10, 0));
+
+        CHECK_EQ(&wire.points(), &wire.points());
+        CHECK_EQ(wire.points().constData(), wire.points().constData());
+    }
+
+    TEST_CASE("Memory & iteration of 1M points")
+    {
+        const int count = 1000000;
+
+        // A point is the coordinates plus the (padded) junction flag. It used to be 32 bytes with the vtable pointer.
+        CHECK_EQ(sizeof(wire_system::point), sizeof(QPointF) + sizeof(qreal));
+
+        QVector<QPointF> input;
+        input.reserve(count);
+        for (int i = 0; i < count; i++)
+            input.append(QPointF(i, i % 100));
+
+        // Storage
+        wire_system::wire wire;
+        std::size_t bytes = 0;
+        {
+            allocation_counter::Counter counter;
+            wire.set_points(input);
+            counter.stop();
+            bytes = counter.allocatedBytes();
+        }
+        const std::size_t storedBytes = static_cast<std::size_t>(wire.points().capacity()) * sizeof(wire_system::point);
+        MESSAGE("Bytes allocated for " << count << " points: " << bytes << " (" << double(bytes) / count << " per point)");
+        MESSAGE("Bytes held by the point array: " << storedBytes);
+        CHECK_GE(bytes, storedBytes);
+        CHECK_LE(bytes, storedBytes + 1024);
+        CHECK_EQ(wire.points().capacity(), count);
+        CHECK_LT(bytes, count * std::size_t(32));
+
+        // Iteration through the accessor neither copies nor allocates
+        qreal sum = 0;
+        int allocations = 0;
+        QElapsedTimer timer;
+        {
+            allocation_counter::Counter counter;
+            timer.start();
+            for (const auto& point : wire.points())
+                sum += point.x();
+            allocations = counter.stop();
+        }
+        MESSAGE("Iterating " << count << " points: " << timer.nsecsElapsed() / 1000 << " us");
+        CHECK_EQ(allocations, 0);
+        CHECK_EQ(sum, qreal(count) * (count - 1) / 2);
+    }
+}
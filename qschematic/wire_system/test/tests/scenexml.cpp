@@ -0,0 +1,227 @@
+#include "../3rdparty/doctest.h"
+#include "../../../scene.hpp"
+#include "../../../scene_xml.hpp"
+#include "../../../items/connector.hpp"
+#include "../../../items/label.hpp"
+#include "../../../items/node.hpp"
+#include "../../../items/wire.hpp"
+#include "../../../items/wirenet.hpp"
+#include "../../../items/wireroundedcorners.hpp"
+
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/xml_oarchive.hpp>
+
+#include <QBuffer>
+#include <QElapsedTimer>
+
+#include <sstream>
+
+using namespace QSchematic;
+
+namespace
+{
+    void
+    populate(Scene& scene, const int count)
+    {
+        scene.setSceneRect(-500, -500, count * 100 + 1000, 1000);
+
+        for (int i = 0; i < count; i++) {
+            auto node = std::make_shared<Items::Node>();
+            node->setPos(i * 100, 0);
+            node->setSize(40, 40);
+            auto connector = std::make_shared<Items::Connector>(Items::Item::ConnectorType, QPoint(2, 0));
+            connector->ensureLabel()->setText(QStringLiteral("c%1").arg(i));
+            node->addConnector(connector);
+            node->addConnector(std::make_shared<Items::Connector>(Items::Item::ConnectorType, QPoint(0, 2)));
+            scene.addItem(node);
+
+            std::shared_ptr<Items::Wire> wire;
+            if (i % 2)
+                wire = std::make_shared<Items::WireRoundedCorners>();
+            else
+                wire = std::make_shared<Items::Wire>();
+            wire->append_point(QPointF(i * 100, 100));
+            wire->append_point(QPointF(i * 100 + 50, 100));
+            wire->append_point(QPointF(i * 100 + 50, 150));
+            scene.addWire(wire);
+            wire->net()->set_name(QStringLiteral("n%1").arg(i));
+        }
+    }
+
+    void
+    compare(const Scene& a, const Scene& b)
+    {
+        const auto& nodesA = a.nodes();
+        const auto& nodesB = b.nodes();
+        REQUIRE_EQ(nodesA.count(), nodesB.count());
+        for (int i = 0; i < nodesA.count(); i++) {
+            CHECK_EQ(nodesA[i]->pos(), nodesB[i]->pos());
+            CHECK_EQ(nodesA[i]->size(), nodesB[i]->size());
+
+            const auto& connectorsA = nodesA[i]->connectors();
+            const auto& connectorsB = nodesB[i]->connectors();
+            REQUIRE_EQ(connectorsA.count(), connectorsB.count());
+            for (int j = 0; j < connectorsA.count(); j++) {
+                CHECK_EQ(connectorsA[j]->pos(), connectorsB[j]->pos());
+                REQUIRE_EQ(connectorsA[j]->hasLabel(), connectorsB[j]->hasLabel());
+                if (connectorsA[j]->hasLabel())
+                    CHECK_EQ(connectorsA[j]->label()->text(), connectorsB[j]->label()->text());
+            }
+        }
+
+        // Boost orders the wires by their net's address, so only compare what doesn't depend on it
+        CHECK_EQ(a.wire_manager()->nets().count(), b.wire_manager()->nets().count());
+        const auto& wiresA = a.wire_manager()->wires();
+        const auto& wiresB = b.wire_manager()->wires();
+        REQUIRE_EQ(wiresA.count(), wiresB.count());
+        int pointsA = 0;
+        int pointsB = 0;
+        for (int i = 0; i < wiresA.count(); i++) {
+            pointsA += wiresA[i]->points_count();
+            pointsB += wiresB[i]->points_count();
+        }
+        CHECK_EQ(pointsA, pointsB);
+    }
+
+    QByteArray
+    writeXml(const Scene& scene)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        XmlWriter writer(&buffer);
+        REQUIRE(writer.write(scene));
+
+        return buffer.data();
+    }
+
+    QByteArray
+    writeBoost(const Scene& scene)
+    {
+        std::ostringstream stream;
+        {
+            boost::archive::xml_oarchive oa(stream);
+            oa << boost::serialization::make_nvp("scene", scene);
+        }
+
+        return QByteArray::fromStdString(stream.str());
+    }
+
+    bool
+    readXml(Scene& scene, const QByteArray& data)
+    {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        XmlReader reader(&buffer);
+        if (!reader.read(scene)) {
+            MESSAGE("XmlReader: " << reader.errorString().toStdString());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool
+    readBoost(Scene& scene, const QByteArray& data)
+    {
+        std::istringstream stream(data.toStdString());
+        try {
+            boost::archive::xml_iarchive ia(stream);
+            ia >> boost::serialization::make_nvp("scene", scene);
+        }
+        catch (const std::exception& e) {
+            MESSAGE("Boost: " << e.what());
+            return false;
+        }
+
+        return true;
+    }
+}
+
+TEST_SUITE("SceneXml")
+{
+    TEST_CASE("Round-trip")
+    {
+        Scene scene;
+        populate(scene, 20);
+
+        Scene loaded;
+        REQUIRE(readXml(loaded, writeXml(scene)));
+        CHECK_EQ(loaded.sceneRect(), scene.sceneRect());
+        compare(scene, loaded);
+
+        // Loaded scenes can be written again
+        Scene reloaded;
+        REQUIRE(readXml(reloaded, writeXml(loaded)));
+        compare(loaded, reloaded);
+    }
+
+    TEST_CASE("Files are Boost XML archives")
+    {
+        Scene scene;
+        populate(scene, 20);
+
+        // Boost reads what the writer writes
+        Scene fromXml;
+        REQUIRE(readBoost(fromXml, writeXml(scene)));
+        compare(scene, fromXml);
+
+        // The reader reads what Boost writes
+        Scene fromBoost;
+        REQUIRE(readXml(fromBoost, writeBoost(scene)));
+        compare(scene, fromBoost);
+    }
+
+    TEST_CASE("Custom types are handed to Boost")
+    {
+        constexpr int customType = QSchematicItemUserType + 1;
+
+        Scene scene;
+        populate(scene, 2);
+        auto node = std::make_shared<Items::Node>(customType);
+        node->setPos(1000, 0);
+        scene.addItem(node);
+
+        Scene loaded;
+        REQUIRE(readXml(loaded, writeXml(scene)));
+        compare(scene, loaded);
+        REQUIRE_EQ(loaded.nodes().count(), 3);
+        CHECK_EQ(loaded.nodes().last()->type(), customType);
+    }
+
+    TEST_CASE("Measurement")
+    {
+        constexpr int count = 10'000;
+
+        Scene scene;
+        populate(scene, count);
+
+        QElapsedTimer timer;
+
+        // Write
+        timer.start();
+        const QByteArray xml = writeXml(scene);
+        const qint64 xmlWrite = timer.nsecsElapsed();
+        timer.restart();
+        const QByteArray archive = writeBoost(scene);
+        const qint64 boostWrite = timer.nsecsElapsed();
+
+        // Read
+        Scene fromXml;
+        timer.restart();
+        REQUIRE(readXml(fromXml, xml));
+        const qint64 xmlRead = timer.nsecsElapsed();
+        Scene fromBoost;
+        timer.restart();
+        REQUIRE(readBoost(fromBoost, archive));
+        const qint64 boostRead = timer.nsecsElapsed();
+
+        compare(scene, fromXml);
+        compare(scene, fromBoost);
+
+        MESSAGE("Scene of " << count << " nodes & wires, XmlWriter/XmlReader vs. Boost XML archive:");
+        MESSAGE("Write: " << xmlWrite / 1'000'000 << " ms vs. " << boostWrite / 1'000'000 << " ms");
+        MESSAGE("Read: " << xmlRead / 1'000'000 << " ms vs. " << boostRead / 1'000'000 << " ms");
+        MESSAGE("Size: " << xml.size() << " bytes vs. " << archive.size() << " bytes");
+    }
+}
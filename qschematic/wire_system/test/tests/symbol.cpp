@@ -0,0 +1,100 @@
+#include "../3rdparty/doctest.h"
+#include "../allocation_counter.hpp"
+#include "../../../items/node.hpp"
+#include "../../../items/symbol.hpp"
+
+#include <memory>
+
+using namespace QSchematic::Items;
+
+namespace
+{
+    std::shared_ptr<SymbolDefinition>
+    makeSymbol(const QString& name, int bodyElements)
+    {
+        auto symbol = std::make_shared<SymbolDefinition>();
+        symbol->name = name;
+        symbol->size = QSizeF(160, 80);
+        for (int i = 0; i < 4; i++)
+            symbol->connectors.push_back({ QPoint(0, i + 1), QString() });
+
+        symbol->body.moveTo(0, 0);
+        for (int i = 0; i < bodyElements; i++)
+            symbol->body.lineTo(i % 160, (i * 7) % 80);
+
+        return symbol;
+    }
+}
+
+TEST_SUITE("Symbol")
+{
+    TEST_CASE("Instances share the definition")
+    {
+        const std::shared_ptr<const SymbolDefinition> symbol = makeSymbol("resistor", 100);
+
+        Node node1;
+        Node node2;
+        node1.setSymbol(symbol);
+        node2.setSymbol(symbol);
+
+        CHECK_EQ(node1.symbol().get(), symbol.get());
+        CHECK_EQ(node2.symbol().get(), symbol.get());
+        CHECK_EQ(node1.connectors().count(), symbol->connectors.count());
+        CHECK_EQ(node2.connectors().count(), symbol->connectors.count());
+        CHECK_NE(node1.connectors().first(), node2.connectors().first());
+    }
+
+    TEST_CASE("Instance memory doesn't depend on the body geometry")
+    {
+        // The body is shared, the connectors & the node state are not. An instance of a symbol with a complex body
+        // must therefore not allocate more than an instance of a symbol with a trivial body.
+        const std::shared_ptr<const SymbolDefinition> simple = makeSymbol("simple", 1);
+        const std::shared_ptr<const SymbolDefinition> complex = makeSymbol("complex", 10000);
+
+        // Warm up so that one-time initializations aren't attributed to the first instance
+        std::make_shared<Node>()->setSymbol(simple);
+
+        std::size_t simpleBytes = 0;
+        {
+            allocation_counter::Counter counter;
+            auto node = std::make_shared<Node>();
+            node->setSymbol(simple);
+            counter.stop();
+            simpleBytes = counter.allocatedBytes();
+        }
+
+        std::size_t complexBytes = 0;
+        {
+            allocation_counter::Counter counter;
+            auto node = std::make_shared<Node>();
+            node->setSymbol(complex);
+            counter.stop();
+            complexBytes = counter.allocatedBytes();
+        }
+
+        MESSAGE("Bytes allocated per instance: " << simpleBytes);
+        MESSAGE("Body geometry shared per instance: " << complex->body.elementCount() * sizeof(QPainterPath::Element));
+        CHECK_EQ(complexBytes, simpleBytes);
+    }
+
+    TEST_CASE("Symbols are re-linked by name")
+    {
+        const std::shared_ptr<const SymbolDefinition> symbol = makeSymbol("capacitor", 10);
+        REQUIRE(SymbolLibrary::instance().add(symbol));
+
+        Node node;
+        node.setSymbol(symbol);
+        const int connectorCount = node.connectors().count();
+
+        Node loaded;
+        CHECK(loaded.linkSymbol("capacitor"));
+        CHECK_EQ(loaded.symbol().get(), symbol.get());
+        CHECK(loaded.connectors().isEmpty());      // Linking doesn't (re-)create the per-instance connectors
+        CHECK_NE(connectorCount, 0);
+
+        CHECK_FALSE(loaded.linkSymbol("unknown"));
+        CHECK_FALSE(loaded.symbol());
+
+        SymbolLibrary::instance().remove("capacitor");
+    }
+}
@@ -47,9 +47,111 @@ TEST_SUITE("Wire")
 
         REQUIRE_EQ(wire->points_count(), 4);
 
-        wire->simplify();
+        CHECK(wire->simplify());
 
         REQUIRE_EQ(wire->points_count(), 2);
+        CHECK_FALSE(wire->simplify());
+    }
+
+    TEST_CASE("Wire can be simplified around modified points")
+    {
+        // Create a wire with an obsolete point at the start and a duplicate point at the end
+        auto wire = std::make_shared<wire_system::wire>();
+        wire->append_point(QPointF(0, 0));
+        wire->append_point(QPointF(10, 0));
+        wire->append_point(QPointF(20, 0));
+        wire->append_point(QPointF(20, 20));
+        wire->append_point(QPointF(40, 20));
+        wire->append_point(QPointF(40, 40));
+        wire->append_point(QPointF(60, 40));
+        wire->append_point(QPointF(60, 40));
+
+        REQUIRE_EQ(wire->points_count(), 8);
+
+        SUBCASE("Only the points around the range are simplified")
+        {
+            CHECK(wire->simplify(7, 7));
+            REQUIRE_EQ(wire->points_count(), 7);
+            CHECK_EQ(wire->points().at(1).toPointF(), QPointF(10, 0));
+
+            CHECK(wire->simplify(1, 1));
+            CHECK_EQ(wire->points_count(), 6);
+        }
+
+        SUBCASE("Nothing changes if the range is already simplified")
+        {
+            CHECK_FALSE(wire->simplify(4, 4));
+            CHECK_EQ(wire->points_count(), 8);
+        }
+    }
+
+    TEST_CASE("Runs of collinear points are simplified")
+    {
+        SUBCASE("Whole wire")
+        {
+            auto wire = std::make_shared<wire_system::wire>();
+            wire->append_point(QPointF(0, 0));
+            wire->append_point(QPointF(10, 0));
+            wire->append_point(QPointF(20, 0));
+            wire->append_point(QPointF(30, 0));
+
+            CHECK(wire->simplify());
+            REQUIRE_EQ(wire->points_count(), 2);
+            CHECK_EQ(wire->points().at(0).toPointF(), QPointF(0, 0));
+            CHECK_EQ(wire->points().at(1).toPointF(), QPointF(30, 0));
+        }
+
+        SUBCASE("Range")
+        {
+            auto wire = std::make_shared<wire_system::wire>();
+            wire->append_point(QPointF(0, 0));
+            wire->append_point(QPointF(0, 10));
+            wire->append_point(QPointF(10, 10));
+            wire->append_point(QPointF(20, 10));
+            wire->append_point(QPointF(30, 10));
+            wire->append_point(QPointF(40, 10));
+            wire->append_point(QPointF(40, 20));
+
+            CHECK(wire->simplify(3, 3));
+            REQUIRE_EQ(wire->points_count(), 4);
+            CHECK_EQ(wire->points().at(0).toPointF(), QPointF(0, 0));
+            CHECK_EQ(wire->points().at(1).toPointF(), QPointF(0, 10));
+            CHECK_EQ(wire->points().at(2).toPointF(), QPointF(40, 10));
+            CHECK_EQ(wire->points().at(3).toPointF(), QPointF(40, 20));
+            CHECK_FALSE(wire->simplify());
+        }
+    }
+
+    TEST_CASE("Only the modified points are simplified")
+    {
+        // Create a wire with an obsolete point at the start
+        auto wire = std::make_shared<wire_system::wire>();
+        wire->append_point(QPointF(0, 0));
+        wire->append_point(QPointF(10, 0));
+        wire->append_point(QPointF(20, 0));
+        wire->append_point(QPointF(20, 10));
+        wire->append_point(QPointF(30, 10));
+        wire->append_point(QPointF(30, 20));
+        wire->append_point(QPointF(40, 20));
+        wire->append_point(QPointF(40, 30));
+
+        // Adding the points counts as modifying them
+        CHECK(wire->simplify_modified());
+        REQUIRE_EQ(wire->points_count(), 7);
+        CHECK_FALSE(wire->simplify_modified());
+
+        // Move the last point onto its neighbour, then insert an obsolete point in front of it
+        wire->move_point_to(6, QPointF(40, 20));
+        wire->insert_point(3, QPointF(25, 10));
+        REQUIRE_EQ(wire->points_count(), 8);
+
+        // Both get simplified even though the moved point was shifted by the insertion
+        CHECK(wire->simplify_modified());
+        REQUIRE_EQ(wire->points_count(), 6);
+        CHECK_EQ(wire->points().at(2).toPointF(), QPointF(20, 10));
+        CHECK_EQ(wire->points().at(3).toPointF(), QPointF(30, 10));
+        CHECK_EQ(wire->points().last().toPointF(), QPointF(40, 20));
+        CHECK_FALSE(wire->simplify_modified());
     }
 
     TEST_CASE("Wires can be moved")
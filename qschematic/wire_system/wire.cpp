@@ -18,7 +18,13 @@ void wire::set_manager(wire_system::manager* manager)
     m_manager = manager;
 }
 
-QVector<point> wire::points() const
+/**
+ * Get the points of this wire.
+ *
+ * @note The returned reference is invalidated by any modification of the wire. Make a copy if the wire may change
+ *       while the points are in use.
+ */
+const QVector<point>& wire::points() const
 {
     return m_points;
 }
@@ -28,12 +34,42 @@ int wire::points_count() const
     return m_points.count();
 }
 
+void
+wire::set_points(const QVector<QPointF>& points)
+{
+    about_to_change();
+    m_points.clear();
+    m_points.reserve(points.size());
+    for (const auto& p : points)
+        m_points.append(point(p));
+    m_modifiedFirst = 0;
+    m_modifiedLast = m_points.count() - 1;
+    has_changed();
+}
+
+/**
+ * Get the indexes of the junction points.
+ *
+ * @note Use junction_indexes() in hot paths, it doesn't allocate.
+ */
 QVector<int> wire::junctions() const
+{
+    const auto indexes = junction_indexes();
+
+    return QVector<int>(indexes.cbegin(), indexes.cend());
+}
+
+/**
+ * Get the indexes of the junction points without allocating.
+ *
+ * @note Only the first & last point can be junctions, so they always fit into the array.
+ */
+QVarLengthArray<int, 2> wire::junction_indexes() const
 {
     if (points_count() < 2) {
         return {};
     }
-    QVector<int> indexes;
+    QVarLengthArray<int, 2> indexes;
     if (m_points.first().is_junction()) {
         indexes.append(0);
     }
@@ -48,6 +84,17 @@ QList<wire*> wire::connected_wires()
     return m_connectedWires;
 }
 
+/**
+ * Get the wires connected to this one without copying the list.
+ *
+ * @note The returned reference is invalidated when wires get connected or disconnected. Use connected_wires() if that
+ *       may happen while iterating.
+ */
+const QList<wire*>& wire::connected_wires_ref() const
+{
+    return m_connectedWires;
+}
+
 QList<line> wire::line_segments() const
 {
     // A line segment requires at least two points... duuuh
@@ -56,13 +103,36 @@ QList<line> wire::line_segments() const
     }
 
     QList<line> ret;
+    ret.reserve(points_count() - 1);
     for (int i = 0; i < points_count() - 1; i++) {
-        ret.append(line(m_points.at(i).toPointF(), m_points.at(i + 1).toPointF()));
+        ret.append(line_segment(i));
     }
 
     return ret;
 }
 
+/**
+ * Get the number of line segments.
+ */
+int wire::line_segments_count() const
+{
+    return qMax(points_count() - 1, 0);
+}
+
+/**
+ * Get a single line segment.
+ *
+ * @details Unlike line_segments() this builds only the requested segment from the points.
+ *
+ * @param index The index of the segment. Must be in [0, line_segments_count()).
+ */
+line wire::line_segment(int index) const
+{
+    Q_ASSERT(index >= 0 && index < line_segments_count());
+
+    return line(m_points.at(index).toPointF(), m_points.at(index + 1).toPointF());
+}
+
 void wire::move_junctions_to_new_segment(const line& oldSegment, const line& newSegment)
 {
     // Do nothing if the segment was just resized
@@ -72,20 +142,20 @@ void wire::move_junctions_to_new_segment(const line& oldSegment, const line& new
 
     // Move connected junctions
     for (const auto& wire: m_connectedWires) {
-        for (const auto& jIndex: wire->junctions()) {
+        for (const auto& jIndex: wire->junction_indexes()) {
             point point = wire->points().at(jIndex);
             // Check if the point is on the old segment
             if (oldSegment.contains_point(point.toPoint(), 5)) {
                 line junctionSeg;
                 // Find out if one of the segments is horizontal or vertical
                 if (jIndex < wire->points().count() - 1) {
-                    line seg = wire->line_segments().at(jIndex);
+                    line seg = wire->line_segment(jIndex);
                     if (seg.is_horizontal() || seg.is_vertical()) {
                         junctionSeg = seg;
                     }
                 }
                 if (jIndex > 0) {
-                    line seg = wire->line_segments().at(jIndex - 1);
+                    line seg = wire->line_segment(jIndex - 1);
                     if (seg.is_horizontal() || seg.is_vertical()) {
                         junctionSeg = seg;
                     }
@@ -127,7 +197,7 @@ void wire::move_point_to(int index, const QPointF& moveTo)
 
     // Move junctions that are on the point
     for (const auto& wire: m_connectedWires) {
-        for (const auto& jIndex: wire->junctions()) {
+        for (const auto& jIndex: wire->junction_indexes()) {
             point point = wire->points().at(jIndex);
             if ((m_points[index]).toPoint() == point.toPoint()) {
                 wire->move_point_by(jIndex, QVector2D(moveTo - m_points[index].toPointF()));
@@ -137,14 +207,14 @@ void wire::move_point_to(int index, const QPointF& moveTo)
 
     // Move junctions on the next segment
     if (index < points_count() - 1) {
-        line segment = line_segments().at(index);
+        line segment = line_segment(index);
         line newSegment(moveTo, points().at(index + 1).toPointF());
         move_junctions_to_new_segment(segment, newSegment);
     }
 
     // Move junctions on the previous segment
     if (index > 0) {
-        line segment = line_segments().at(index - 1);
+        line segment = line_segment(index - 1);
         line newSegment(points().at(index - 1).toPointF(), moveTo);
         move_junctions_to_new_segment(segment, newSegment);
     }
@@ -152,6 +222,7 @@ void wire::move_point_to(int index, const QPointF& moveTo)
     point wirepoint = moveTo;
     wirepoint.set_is_junction(m_points[index].is_junction());
     m_points[index] = wirepoint;
+    mark_modified(index, index);
 }
 
 /**
@@ -187,6 +258,8 @@ void wire::prepend_point(const QPointF& point)
 {
     about_to_change();
     m_points.prepend(wire_system::point(point));
+    shift_modified(0, 1);
+    mark_modified(0, 0);
     has_changed();
 
     // Update junction
@@ -202,6 +275,7 @@ void wire::append_point(const QPointF& point)
 {
     about_to_change();
     m_points.append(wire_system::point(point));
+    mark_modified(points_count() - 1, points_count() - 1);
     has_changed();
 
     // Update junction
@@ -229,9 +303,9 @@ void wire::move_line_segment_by(int index, const QVector2D& moveBy)
 
     // Move connected junctions
     for (const auto& wire: m_connectedWires) {
-        for (const auto& jIndex: wire->junctions()) {
+        for (const auto& jIndex: wire->junction_indexes()) {
             point point = wire->points().at(jIndex);
-            line segment = line_segments().at(index);
+            line segment = line_segment(index);
             if (segment.contains_point(point.toPointF())) {
                 // Don't move it if it is on one of the points
                 if (segment.p1().toPoint() == point.toPoint() || segment.p2().toPoint() == point.toPoint()) {
@@ -243,7 +317,7 @@ void wire::move_line_segment_by(int index, const QVector2D& moveBy)
     }
 
     // If this is the first or last segment we might need to add a new segment
-    if (index == 0 || index == line_segments().count() - 1) {
+    if (index == 0 || index == line_segments_count() - 1) {
         // Get the correct point
         point point;
         if (index == 0) {
@@ -298,7 +372,7 @@ void wire::insert_point(int index, const QPointF& point)
         return;
     }
 
-    line segment = line_segments().at(index - 1);
+    line segment = line_segment(index - 1);
     // If the point is not on the segment, move the junctions
     if (!segment.contains_point(point)) {
         // Find the closest point on the segment
@@ -320,6 +394,8 @@ void wire::insert_point(int index, const QPointF& point)
     } else {
         m_points.insert(index, point);
     }
+    shift_modified(index, 1);
+    mark_modified(index, index);
     has_changed();
 
     if (m_manager) {
@@ -342,7 +418,7 @@ void wire::move_point_by(int index, const QVector2D& moveBy)
     // straight angles, we need to insert two additional points if we are not moving in
     // the direction of the line.
     if (points_count() == 2 && m_manager->settings().preserveStraightAngles) {
-        const line line = line_segments().first();
+        const line line = line_segment(0);
 
         bool moveVertically = line.is_horizontal() && !qFuzzyIsNull(moveBy.y());
         bool moveHorizontally = line.is_vertical() && !qFuzzyIsNull(moveBy.x());
@@ -404,7 +480,7 @@ void wire::move_point_by(int index, const QVector2D& moveBy)
             if (!line.is_null() && (line.is_horizontal() || line.is_vertical())) {
                 // Move connected junctions
                 for (const auto& wire: m_connectedWires) {
-                    for (const auto& jIndex: wire->junctions()) {
+                    for (const auto& jIndex: wire->junction_indexes()) {
                         const auto& point = wire->points().at(jIndex);
                         if (line.contains_point(point.toPointF())) {
                             // Don't move it if it is on one of the points
@@ -444,7 +520,7 @@ void wire::move_point_by(int index, const QVector2D& moveBy)
             if (!line.is_null() && (line.is_horizontal() || line.is_vertical())) {
                 // Move connected junctions
                 for (const auto& wire: m_connectedWires) {
-                    for (const auto& jIndex: wire->junctions()) {
+                    for (const auto& jIndex: wire->junction_indexes()) {
                         const auto& point = wire->points().at(jIndex);
                         if (line.contains_point(point.toPointF())) {
                             // Don't move it if it is on one of the points
@@ -477,8 +553,8 @@ void wire::move_point_by(int index, const QVector2D& moveBy)
 
 bool wire::point_is_on_wire(const QPointF& point) const
 {
-    for (const line& lineSegment : line_segments()) {
-        if (lineSegment.contains_point(point, 0)) {
+    for (int i = 0; i < line_segments_count(); i++) {
+        if (line_segment(i).contains_point(point, 0)) {
             return true;
         }
     }
@@ -494,10 +570,11 @@ void wire::move(const QVector2D& movedBy)
     }
 
     // Move junctions
-    for (const auto& index : junctions()) {
-        const auto& junction = points().at(index);
+    for (const auto& index : junction_indexes()) {
+        // Copy, moving the point may insert points
+        const point junction = points().at(index);
         for (const auto& wire : net()->wires()) {
-            if (!wire->connected_wires().contains(this)) {
+            if (!wire->connected_wires_ref().contains(this)) {
                 continue;
             }
             if (wire->point_is_on_wire(junction.toPointF()) && !movedBy.isNull()) {
@@ -507,8 +584,8 @@ void wire::move(const QVector2D& movedBy)
     }
 
     // Move junction on the wire
-    for (const auto& wire : connected_wires()) {
-        for (const auto& index : wire->junctions()) {
+    for (const auto& wire : connected_wires_ref()) {
+        for (const auto& index : wire->junction_indexes()) {
             const auto& point = wire->points().at(index);
             if (point_is_on_wire(point.toPointF())) {
                 wire->move_point_by(index, movedBy);
@@ -522,60 +599,189 @@ void wire::move(const QVector2D& movedBy)
     }
 }
 
-void wire::remove_duplicate_points()
+/**
+ * Checks whether simplifying the points in [first, last] would change anything.
+ */
+bool wire::can_simplify(int first, int last) const
 {
-    int i = 0;
-    while (i < points_count() - 1 && points_count() > 2) {
-        point p1 = points().at(i);
-        point p2 = points().at(i + 1);
+    // Duplicate points
+    if (points_count() > 2) {
+        for (int i = first; i < last; i++) {
+            if (m_points.at(i) == m_points.at(i + 1)) {
+                return true;
+            }
+        }
+    }
+
+    // Obsolete points (only the ones in between first and last)
+    if (points_count() >= 3) {
+        for (int i = first + 2; i <= last; i++) {
+            const QLineF segment(m_points.at(i - 2).toPointF(), m_points.at(i - 1).toPointF());
+            if (Utils::pointIsOnLine(segment, m_points.at(i).toPointF())) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Removes consecutive duplicates of the points in [first, last].
+ *
+ * @return The number of removed points.
+ */
+int wire::remove_duplicate_points(int first, int last)
+{
+    int removed = 0;
+    int i = first;
+    while (i < last - removed && points_count() > 2) {
+        const bool p1IsJunction = m_points.at(i).is_junction();
+        const bool p2IsJunction = m_points.at(i + 1).is_junction();
 
         // Check if p2 is the same as p1
-        if (p1 == p2) {
+        if (m_points.at(i) == m_points.at(i + 1)) {
             // If p1 is not a junction itself then inherit from p2
-            if (!p1.is_junction()) {
-                set_point_is_junction(i, p2.is_junction());
+            if (!p1IsJunction) {
+                set_point_is_junction(i, p2IsJunction);
             }
             if (m_manager) {
                 m_manager->point_removed(this, i + 1);
             }
             m_points.removeAt(i + 1);
+            shift_modified(i + 1, -1);
+            removed++;
         } else {
             i++;
         }
     }
+
+    return removed;
 }
 
-void wire::remove_obsolete_points()
+/**
+ * Removes the points in ]first, last[ which lay on the line formed by their neighbours.
+ */
+void wire::remove_obsolete_points(int first, int last)
 {
     // Don't do anything if there are not at least three line segments
     if (points_count() < 3) {
         return;
     }
 
-    // Compile a list of obsolete points
-    auto it = m_points.begin() + 2;
-    while (it != m_points.end()) {
-        QPointF p1 = (*(it - 2)).toPointF();
-        QPointF p2 = (*(it - 1)).toPointF();
-        QPointF p3 = (*it).toPointF();
+    int i = first + 2;
+    while (i <= last && i < points_count()) {
+        QPointF p1 = m_points.at(i - 2).toPointF();
+        QPointF p2 = m_points.at(i - 1).toPointF();
+        QPointF p3 = m_points.at(i).toPointF();
 
         // Check if p2 is on the line created by p1 and p3
         if (Utils::pointIsOnLine(QLineF(p1, p2), p3)) {
             if (m_manager) {
-                m_manager->point_removed(this, m_points.indexOf(*(it - 1)));
+                m_manager->point_removed(this, i - 1);
             }
-            it = m_points.erase(it - 1);
+            m_points.removeAt(i - 1);
+            shift_modified(i - 1, -1);
+            last--;
+
+            // The next point is now at i, check it against p1 & p3
+            continue;
         }
-        it++;
+        i++;
     }
 }
 
-void wire::simplify()
+/**
+ * Removes duplicate and obsolete points.
+ *
+ * @return Whether the wire changed.
+ */
+bool wire::simplify()
 {
+    return simplify(0, points_count() - 1);
+}
+
+/**
+ * Removes duplicate and obsolete points around the points in [first, last].
+ *
+ * @details Use this instead of simplify() if only some of the points were modified. A point can only become
+ *          duplicate or obsolete through its two neighbours on either side, so only those are inspected.
+ *          Nothing is done (and the change notifications are not emitted) if there is nothing to simplify.
+ *
+ * @param first The index of the first modified point.
+ * @param last The index of the last modified point.
+ * @return Whether the wire changed.
+ */
+bool wire::simplify(int first, int last)
+{
+    // All the modified points get looked at
+    if (m_modifiedFirst >= first && m_modifiedLast <= last) {
+        m_modifiedFirst = -1;
+        m_modifiedLast = -1;
+    }
+
+    first = qMax(first - 2, 0);
+    last = qMin(last + 2, points_count() - 1);
+    if (first >= last || !can_simplify(first, last)) {
+        return false;
+    }
+
     about_to_change();
-    remove_duplicate_points();
-    remove_obsolete_points();
+    const int removed = remove_duplicate_points(first, last);
+    remove_obsolete_points(first, last - removed);
     has_changed();
+
+    return true;
+}
+
+/**
+ * Removes duplicate and obsolete points around the points modified since the last simplification.
+ *
+ * @details This is the cheap way to keep wires simplified after moving things around: Wires that weren't modified
+ *          return right away and the others only look at the range of points that was modified.
+ *
+ * @return Whether the wire changed.
+ */
+bool wire::simplify_modified()
+{
+    if (m_modifiedFirst < 0) {
+        return false;
+    }
+
+    return simplify(m_modifiedFirst, m_modifiedLast);
+}
+
+/**
+ * Adds the points in [first, last] to the range of points modified since the last simplification.
+ */
+void wire::mark_modified(int first, int last)
+{
+    if (m_modifiedFirst < 0) {
+        m_modifiedFirst = first;
+        m_modifiedLast = last;
+        return;
+    }
+
+    m_modifiedFirst = qMin(m_modifiedFirst, first);
+    m_modifiedLast = qMax(m_modifiedLast, last);
+}
+
+/**
+ * Keeps the range of modified points in sync after inserting (positive count) or removing (negative count) points
+ * at index.
+ */
+void wire::shift_modified(int index, int count)
+{
+    if (m_modifiedFirst < 0) {
+        return;
+    }
+
+    if (m_modifiedFirst >= index) {
+        m_modifiedFirst = qMax(m_modifiedFirst + count, index);
+    }
+    if (m_modifiedLast >= index) {
+        m_modifiedLast = qMax(m_modifiedLast + count, index);
+    }
 }
 
 bool wire::connect_wire(wire* wire)
@@ -608,22 +814,24 @@ void wire::remove_point(int index)
     // Move the junction on the previous and next segments
     if (index > 0 && index < points_count() - 1) {
         line newSegment(points().at(index - 1).toPointF(), points().at(index + 1).toPointF());
-        move_junctions_to_new_segment(line_segments().at(index - 1), newSegment);
-        move_junctions_to_new_segment(line_segments().at(index), newSegment);
+        move_junctions_to_new_segment(line_segment(index - 1), newSegment);
+        move_junctions_to_new_segment(line_segment(index), newSegment);
     } else {
-        for (const auto& wire: connected_wires()) {
-            for (int junctionIndex: wire->junctions()) {
+        for (const auto& wire: connected_wires_ref()) {
+            for (int junctionIndex: wire->junction_indexes()) {
                 QPointF point = wire->points().at(junctionIndex).toPointF();
-                if (line_segments().first().contains_point(point)) {
+                if (line_segment(0).contains_point(point)) {
                     wire->move_point_to(junctionIndex, points().at(1).toPointF());
                 }
-                if (line_segments().last().contains_point(point)) {
+                if (line_segment(line_segments_count() - 1).contains_point(point)) {
                     wire->move_point_to(junctionIndex, points().at(points_count() - 2).toPointF());
                 }
             }
         }
     }
     m_points.remove(index);
+    shift_modified(index, -1);
+    mark_modified(qMax(index - 1, 0), index);
     has_changed();
     if (m_manager) {
         m_manager->point_removed(this, index);
@@ -3,6 +3,7 @@
 #include "point.hpp"
 
 #include <QList>
+#include <QVarLengthArray>
 #include <QVector>
 
 #include <memory>
@@ -20,6 +21,13 @@ namespace wire_system
      *
      * @details A wire consists of zero or more line segments. A line segment's point can connect to connectables or
      *          other wire segments.
+     *
+     * @note The points are stored as one array of point (coordinates & junction flag), not as compact integer grid
+     *       coordinates in separate arrays with a junction bitset. points() hands out a reference to contiguous point
+     *       objects which callers iterate and index directly, so a structure-of-arrays layout can't back it without
+     *       copying or breaking the API. The coordinates can't be integers either: wires without a manager aren't
+     *       snapped at all, Items::Item::setSnapToGrid() turns snapping off per item and the grid size of a scene can
+     *       change at runtime.
      */
     class wire
     {
@@ -30,11 +38,15 @@ namespace wire_system
         virtual ~wire() = default;
 
         void set_manager(manager* manager);
-        [[nodiscard]] QVector<point> points() const;
+        [[nodiscard]] const QVector<point>& points() const;
         [[nodiscard]] int points_count() const;
         [[nodiscard]] QVector<int> junctions() const;
+        [[nodiscard]] QVarLengthArray<int, 2> junction_indexes() const;
         [[nodiscard]] QList<wire*> connected_wires();
+        [[nodiscard]] const QList<wire*>& connected_wires_ref() const;
         [[nodiscard]] QList<line> line_segments() const;
+        [[nodiscard]] int line_segments_count() const;
+        [[nodiscard]] line line_segment(int index) const;
         virtual void move_point_to(int index, const QPointF& moveTo);
         void set_point_is_junction(int index, bool isJunction);
         virtual void prepend_point(const QPointF& point);
@@ -43,7 +55,9 @@ namespace wire_system
         void move_point_by(int index, const QVector2D& moveBy);
         [[nodiscard]] bool point_is_on_wire(const QPointF& point) const;
         void move(const QVector2D& movedBy);
-        void simplify();
+        bool simplify();
+        bool simplify(int first, int last);
+        bool simplify_modified();
         [[nodiscard]] bool connect_wire(wire* wire);
         void setNet(const std::shared_ptr<wire_system::net>& net);
         [[nodiscard]] std::shared_ptr<wire_system::net> net();
@@ -51,9 +65,22 @@ namespace wire_system
         virtual void add_segment(int index);
         void remove_point(int index);
 
+        /**
+         * Replaces all points of the wire.
+         *
+         * @note This does not notify the manager. It's meant to populate wires which are not yet part of a manager
+         *       (eg. while loading from a file).
+         *
+         * @param points The new points.
+         */
+        void
+        set_points(const QVector<QPointF>& points);
+
     protected:
         void move_junctions_to_new_segment(const line& oldSegment, const line& newSegment);
         void move_line_segment_by(int index, const QVector2D& moveBy);
+        void mark_modified(int first, int last);
+        void shift_modified(int index, int count);
 
         [[nodiscard]]
         class manager*
@@ -65,13 +92,16 @@ namespace wire_system
         QVector<point> m_points;
 
     private:
-        void remove_duplicate_points();
-        void remove_obsolete_points();
+        [[nodiscard]] bool can_simplify(int first, int last) const;
+        int remove_duplicate_points(int first, int last);
+        void remove_obsolete_points(int first, int last);
         virtual void about_to_change();
         virtual void has_changed();
 
         QList<wire*> m_connectedWires;
         std::shared_ptr<wire_system::net> m_net;
         class manager* m_manager;
+        int m_modifiedFirst = -1;       // The points modified since the last simplification, -1 if none
+        int m_modifiedLast = -1;
     };
 }